@@ -1,16 +1,22 @@
 #include <stdio.h>
+#include "fibonacci_utils.h"
+
+/* Compile: gcc Q4.c fibonacci_utils.c bignum.c -o Q4 */
 int main()
-{   int n;
+{   long long n;
     printf("enter the terms of fib series");
-    scanf("%d", &n);
-    int arr[100];
-    arr[0] =0;
-    arr[1] =1;
-    printf("%d\t%d\t",arr[0],arr[1]);
-    for(int i=2;i<=n;i++) {
-      arr[i] =arr[i-1]+arr[i-2];
-      printf("%d\t",arr[i]);
+    if (scanf("%lld", &n) != 1 || n < 1) {
+      printf("number of terms must be at least 1\n");
+      return 1;
+    }
+    FibonacciSequence seq;
+    fibonacciSequenceInit(&seq);
+    printf("%d\t",0);
+    for(long long i=1;i<=n;i++) {
+      bigNumPrint(stdout, fibonacciSequenceNext(&seq));
+      printf("\t");
     }
+    fibonacciSequenceFree(&seq);
 
 
    
@@ -1,580 +1,359 @@
 #include <stdio.h>
-#include<conio.h>
-#include<direct.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "premium_utils.h"
+#include "output_sink.h"
 
-int A()
+/* Compile: gcc alphabet_patterns.c output_sink.c -o alphabet_patterns (add -DPERF_COUNTERS=1 -DPREMIUM_UTILS_NO_MAIN premium_utils.c -pthread -lm for hardware counters) */
+/* Usage:   ./alphabet_patterns [TEXT [SCALE]]  (with TEXT, prints it as a horizontal banner) */
+
+/*
+ * 5x5 bitmap font. Each glyph is one byte per row, bit 4 being the leftmost
+ * column, so adding a character is one line of data. A cell prints as " *"
+ * when its bit is set and "  " otherwise; glyphRows holds the printed form
+ * of all 32 possible rows, so rendering a row is a single table lookup.
+ * Characters without a glyph (lowercase, most symbols) print nothing.
+ */
+#define GLYPH_WIDTH 5
+#define GLYPH_HEIGHT 5
+#define GLYPH_ROW_BYTES (2 * GLYPH_WIDTH + 1) /* two bytes per cell, then '\n' */
+#define GLYPH_BYTES (GLYPH_HEIGHT * GLYPH_ROW_BYTES)
+
+/*
+ * Banners put the glyphs side by side. A pixel is scale rows high and
+ * 2 * scale columns wide (terminal cells are about twice as tall as they
+ * are wide), and glyphs are one blank pixel apart.
+ */
+#define BANNER_MAX_SCALE 32
+
+static const unsigned char glyphs[128][GLYPH_HEIGHT] = {
+    ['A'] = {0x1F, 0x11, 0x1F, 0x11, 0x11},
+    ['B'] = {0x1F, 0x09, 0x0F, 0x09, 0x1F},
+    ['C'] = {0x1F, 0x10, 0x10, 0x10, 0x1F},
+    ['D'] = {0x1F, 0x09, 0x09, 0x09, 0x1F},
+    ['E'] = {0x1F, 0x10, 0x1F, 0x10, 0x1F},
+    ['F'] = {0x1F, 0x10, 0x1F, 0x10, 0x10},
+    ['G'] = {0x1F, 0x10, 0x17, 0x11, 0x1F},
+    ['H'] = {0x11, 0x11, 0x1F, 0x11, 0x11},
+    ['I'] = {0x0E, 0x04, 0x04, 0x04, 0x0E},
+    ['J'] = {0x1F, 0x04, 0x04, 0x14, 0x1C},
+    ['K'] = {0x12, 0x14, 0x18, 0x14, 0x12},
+    ['L'] = {0x10, 0x10, 0x10, 0x10, 0x1E},
+    ['M'] = {0x11, 0x1B, 0x15, 0x11, 0x11},
+    ['N'] = {0x11, 0x19, 0x15, 0x13, 0x11},
+    ['O'] = {0x1F, 0x11, 0x11, 0x11, 0x1F},
+    ['P'] = {0x1F, 0x11, 0x1F, 0x10, 0x10},
+    ['Q'] = {0x1F, 0x11, 0x15, 0x1F, 0x02},
+    ['R'] = {0x1E, 0x14, 0x18, 0x14, 0x12},
+    ['S'] = {0x1F, 0x10, 0x1F, 0x01, 0x1F},
+    ['T'] = {0x1F, 0x04, 0x04, 0x04, 0x04},
+    ['U'] = {0x11, 0x11, 0x11, 0x11, 0x1F},
+    ['V'] = {0x11, 0x00, 0x0A, 0x04, 0x00},
+    ['W'] = {0x11, 0x11, 0x15, 0x1B, 0x11},
+    ['X'] = {0x11, 0x0A, 0x04, 0x0A, 0x11},
+    ['Y'] = {0x11, 0x0A, 0x04, 0x04, 0x04},
+    ['Z'] = {0x1F, 0x02, 0x04, 0x08, 0x1F},
+    ['0'] = {0x1F, 0x13, 0x15, 0x19, 0x1F},
+    ['1'] = {0x04, 0x0C, 0x04, 0x04, 0x0E},
+    ['2'] = {0x1F, 0x01, 0x1F, 0x10, 0x1F},
+    ['3'] = {0x1F, 0x01, 0x0F, 0x01, 0x1F},
+    ['4'] = {0x11, 0x11, 0x1F, 0x01, 0x01},
+    ['5'] = {0x1F, 0x10, 0x1E, 0x01, 0x1E},
+    ['6'] = {0x1F, 0x10, 0x1F, 0x11, 0x1F},
+    ['7'] = {0x1F, 0x01, 0x02, 0x04, 0x04},
+    ['8'] = {0x1F, 0x11, 0x1F, 0x11, 0x1F},
+    ['9'] = {0x1F, 0x11, 0x1F, 0x01, 0x1F},
+    ['!'] = {0x04, 0x04, 0x04, 0x00, 0x04},
+    ['"'] = {0x0A, 0x0A, 0x00, 0x00, 0x00},
+    ['#'] = {0x0A, 0x1F, 0x0A, 0x1F, 0x0A},
+    ['\''] = {0x04, 0x04, 0x00, 0x00, 0x00},
+    ['('] = {0x02, 0x04, 0x04, 0x04, 0x02},
+    [')'] = {0x08, 0x04, 0x04, 0x04, 0x08},
+    ['*'] = {0x00, 0x15, 0x0E, 0x15, 0x00},
+    ['+'] = {0x00, 0x04, 0x1F, 0x04, 0x00},
+    [','] = {0x00, 0x00, 0x00, 0x04, 0x08},
+    ['-'] = {0x00, 0x00, 0x1F, 0x00, 0x00},
+    ['.'] = {0x00, 0x00, 0x00, 0x00, 0x04},
+    ['/'] = {0x01, 0x02, 0x04, 0x08, 0x10},
+    [':'] = {0x00, 0x04, 0x00, 0x04, 0x00},
+    ['='] = {0x00, 0x1F, 0x00, 0x1F, 0x00},
+    ['?'] = {0x1F, 0x01, 0x07, 0x00, 0x04},
+    ['_'] = {0x00, 0x00, 0x00, 0x00, 0x1F},
+};
+
+static const char glyphRows[1 << GLYPH_WIDTH][GLYPH_ROW_BYTES + 1] = {
+    "          \n",
+    "         *\n",
+    "       *  \n",
+    "       * *\n",
+    "     *    \n",
+    "     *   *\n",
+    "     * *  \n",
+    "     * * *\n",
+    "   *      \n",
+    "   *     *\n",
+    "   *   *  \n",
+    "   *   * *\n",
+    "   * *    \n",
+    "   * *   *\n",
+    "   * * *  \n",
+    "   * * * *\n",
+    " *        \n",
+    " *       *\n",
+    " *     *  \n",
+    " *     * *\n",
+    " *   *    \n",
+    " *   *   *\n",
+    " *   * *  \n",
+    " *   * * *\n",
+    " * *      \n",
+    " * *     *\n",
+    " * *   *  \n",
+    " * *   * *\n",
+    " * * *    \n",
+    " * * *   *\n",
+    " * * * *  \n",
+    " * * * * *\n",
+};
+
+/* Tells whether c has a glyph; space is the only blank one */
+static int hasGlyph(unsigned char c)
 {
-    int i, j;
-    for (i = 1; i <= 5; i++)
-    {
-        for (j = 1; j <= 5; j++)
-        {
-            if (i == 1 || j == 1 || j == 5 || i == 3)
-            {
-                printf(" *");
-            }
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
-    }
-    return 0;
+    if (c >= 128)
+        return 0;
+    const unsigned char *rows = glyphs[c];
+    return c == ' ' || (rows[0] | rows[1] | rows[2] | rows[3] | rows[4]) != 0;
 }
-int B()
-{
-    int i, j;
-    for (i = 1; i <= 5; i++)
-    {
-        for (j = 1; j <= 5; j++)
-        {
-            if (i == 1 || j == 2 && i == 2 || j == 5 || i == 5 || i == 4 && j == 2 || j == 2 && i == 3 || j == 3 && i == 3 || j == 4 && i == 3)
-            {
-                printf(" *");
-            }
 
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
-    }
-    return 0;
-}
-int C()
+/* Writes the glyph for c to buffer; returns the bytes written (0 without a glyph) */
+static size_t renderGlyph(char *buffer, unsigned char c)
 {
-    int i, j;
-    for (i = 1; i <= 5; i++)
-    {
-        for (j = 1; j <= 5; j++)
-        {
-            if (i == 1 || j == 1 || i == 5)
-            {
-                printf(" *");
-            }
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
-    }
-    return 0;
+    if (!hasGlyph(c))
+        return 0;
+    for (int row = 0; row < GLYPH_HEIGHT; row++)
+        memcpy(buffer + row * GLYPH_ROW_BYTES, glyphRows[glyphs[c][row]], GLYPH_ROW_BYTES);
+    return GLYPH_BYTES;
 }
-int D()
-{
-    int i, j;
-    for (i = 1; i <= 5; i++)
-    {
-        for (j = 1; j <= 5; j++)
-        {
-            if (i == 1 || j == 2 || j == 5 || i == 5)
-            {
-                printf(" *");
-            }
 
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
-    }
-    return 0;
-}
-int E()
+/* Prints word (capitals, digits and some punctuation), one letter under the other */
+void printWord(FILE *out, const char *word)
 {
-    int i, j;
-    for (i = 1; i <= 5; i++)
-    {
-        for (j = 1; j <= 5; j++)
-        {
-            if (i == 1 || i == 3 || j == 1 || i == 5)
-            {
-                printf(" *");
-            }
+    char buffer[4096];
+    size_t used = 0;
 
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
-    }
-    return 0;
-}
-int F()
-{
-    int i, j;
-    for (i = 1; i <= 5; i++)
+    PERF_REGION_BEGIN(word);
+    for (int i = 0; word[i] != '\0'; i++)
     {
-        for (j = 1; j <= 5; j++)
+        if (used + GLYPH_BYTES + 1 > sizeof(buffer))
         {
-            if (i == 1 || i == 3 || j == 1)
-            {
-                printf(" *");
-            }
-
-            else
-            {
-                printf("  ");
-            }
+            fwrite(buffer, 1, used, out);
+            used = 0;
         }
-        printf("\n");
+        if (i > 0)
+            buffer[used++] = '\n';
+        used += renderGlyph(buffer + used, (unsigned char)word[i]);
     }
-    return 0;
+    fwrite(buffer, 1, used, out);
+    PERF_REGION_END(word);
 }
-int G()
-{
-    int i, j;
-    for (i = 1; i <= 5; i++)
-    {
-        for (j = 1; j <= 5; j++)
-        {
-            if (i == 1 || j == 1 || i == 5 || i == 4 && j == 5 || i == 3 && j == 5 || i == 3 && j == 4 || i == 3 && j == 3)
-            {
-                printf(" *");
-            }
 
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
-    }
-    return 0;
-}
-int H()
+/* Same as printWord(), drawing the glyphs straight into the sink's buffer */
+void writeWord(OutputSink *sink, const char *word)
 {
-    int i, j;
-    for (i = 1; i <= 5; i++)
+    PERF_REGION_BEGIN(word);
+    for (int i = 0; word[i] != '\0'; i++)
     {
-        for (j = 1; j <= 5; j++)
-        {
-            if (i == 3 || j == 1 || j == 5)
-            {
-                printf(" *");
-            }
-
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
+        char *out = sinkReserve(sink, GLYPH_BYTES + 1);
+        size_t used = 0;
+        if (i > 0)
+            out[used++] = '\n';
+        used += renderGlyph(out + used, (unsigned char)word[i]);
+        sinkCommit(sink, used);
     }
-    return 0;
+    PERF_REGION_END(word);
 }
-int I()
-{
-    int i, j;
-    for (i = 1; i <= 5; i++)
-    {
-        for (j = 1; j <= 5; j++)
-        {
-            if (i == 1 && j == 2 || i == 1 && j == 4 || j == 3 || i == 5 && j == 2 || i == 5 && j == 4)
-            {
-                printf(" *");
-            }
 
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
-    }
-    return 0;
-}
-int J()
+/* Glyph for c in a banner, with lowercase drawn as uppercase; NULL if there is none */
+static const unsigned char *bannerGlyph(unsigned char c)
 {
-    int i, j;
-    for (i = 1; i <= 5; i++)
-    {
-        for (j = 1; j <= 5; j++)
-        {
-            if (i == 1 || j == 3 || i == 5 && j == 2 || i == 5 && j == 1 || i == 4 && j == 1)
-            {
-                printf(" *");
-            }
-
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
-    }
-    return 0;
+    if (c >= 'a' && c <= 'z')
+        c -= 'a' - 'A';
+    return hasGlyph(c) ? glyphs[c] : NULL;
 }
-int K()
-{
-    int i, j;
-    for (i = 1; i <= 5; i++)
-    {
-        for (j = 1; j <= 5; j++)
-        {
-            if (j == 1 || i == 3 && j == 2 || j == 3 && i == 2 || j == 4 && i == 1 || i == 4 && j == 3 || i == 5 && j == 4)
-            {
-                printf(" *");
-            }
 
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
-    }
-    return 0;
-}
-int L()
+/* Number of bytes composeBanner() writes for text (0 if nothing would be drawn) */
+size_t bannerSize(const char *text, int scale, const char *color)
 {
-    int i, j;
-    for (i = 1; i <= 5; i++)
-    {
-        for (j = 1; j <= 5; j++)
-        {
-            if (i == 5 && j == 2 || i == 5 && j == 3 || i == 5 && j == 4 || j == 1)
-            {
-                printf(" *");
-            }
+    size_t count = 0;
+    for (const char *p = text; *p != '\0'; p++)
+        count += bannerGlyph((unsigned char)*p) != NULL;
+    if (count == 0 || scale < 1 || scale > BANNER_MAX_SCALE)
+        return 0;
 
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
-    }
-    return 0;
+    size_t pixel = 2 * (size_t)scale;
+    size_t width = count * GLYPH_WIDTH * pixel + (count - 1) * pixel;
+    size_t size = GLYPH_HEIGHT * (size_t)scale * (width + 1);
+    if (color != NULL && color[0] != '\0')
+        size += strlen(color) + strlen(RESET);
+    return size;
 }
-int M()
-{
 
-    int i, j;
-    for (i = 1; i <= 5; i++)
-    {
-        for (j = 1; j <= 5; j++)
-        {
-            if (j == 1 || j == 5 || i == 3 && j == 3 || i == 2 && j == 2 || i == 2 && j == 4)
-            {
-                printf(" *");
-            }
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
-    }
-    return 0;
-}
-int N()
+/*
+ * Lays text out as a banner in buffer, which must hold bannerSize() bytes.
+ * Each of the 32 possible glyph rows is drawn (gap included) the first time
+ * it is needed, so a line is one memcpy per glyph; the line is then copied
+ * scale - 1 times. Returns the number of bytes written.
+ */
+size_t composeBanner(char *buffer, const char *text, int scale, char fill_char, const char *color)
 {
-    int i, j;
-    for (i = 1; i <= 5; i++)
+    const char ink[2] = {' ', fill_char};
+    char pieces[1 << GLYPH_WIDTH][(GLYPH_WIDTH + 1) * 2 * BANNER_MAX_SCALE];
+    uint32_t drawn = 0;
+    size_t pixel = 2 * (size_t)scale;
+    size_t piece = (GLYPH_WIDTH + 1) * pixel; /* leading gap, then the glyph row */
+    char *out = buffer;
+
+    if (bannerSize(text, scale, color) == 0)
+        return 0;
+
+    int colored = color != NULL && color[0] != '\0';
+    if (colored)
     {
-        for (j = 1; j <= 5; j++)
-        {
-            if (i == j || j == 1 || j == 5)
-            {
-                printf(" *");
-            }
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
+        memcpy(out, color, strlen(color));
+        out += strlen(color);
     }
-    return 0;
-}
-int O()
-{
-    int i, j;
-    for (i = 1; i <= 5; i++)
-    {
-        for (j = 1; j <= 5; j++)
-        {
-            if (i == 1 || j == 1 || i == 5 || j == 5)
-            {
-                printf(" *");
-            }
 
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
-    }
-    return 0;
-}
-int P()
-{
-    int i, j;
-    for (i = 1; i <= 5; i++)
+    for (int row = 0; row < GLYPH_HEIGHT; row++)
     {
-        for (j = 1; j <= 5; j++)
+        char *line = out;
+        int first = 1;
+        for (const char *p = text; *p != '\0'; p++)
         {
-            if (i == 1 || j == 1 || i == 3 || j == 5 && i == 2)
+            const unsigned char *glyph = bannerGlyph((unsigned char)*p);
+            if (glyph == NULL)
+                continue;
+            unsigned bits = glyph[row];
+            if (!(drawn >> bits & 1))
             {
-                printf(" *");
+                memset(pieces[bits], ' ', pixel);
+                for (int bit = GLYPH_WIDTH - 1; bit >= 0; bit--)
+                    memset(pieces[bits] + (GLYPH_WIDTH - bit) * pixel, ink[(bits >> bit) & 1], pixel);
+                drawn |= 1u << bits;
             }
 
-            else
-            {
-                printf("  ");
-            }
+            // The first glyph of a line has no gap in front of it
+            size_t skip = first ? pixel : 0;
+            memcpy(out, pieces[bits] + skip, piece - skip);
+            out += piece - skip;
+            first = 0;
         }
-        printf("\n");
-    }
-    return 0;
-}
-int Q()
-{
-    int i, j;
-    for (i = 1; i <= 5; i++)
-    {
-        for (j = 1; j <= 5; j++)
-        {
-            if (i == 1 || i == 2 && j == 1 || i == 3 && j == 1 || i == 4 || i == 2 && j == 5 || i == 3 && j == 5 || i == 3 && j == 3 || i == 5 && j == 4)
-            {
-                printf(" *");
-            }
+        *out++ = '\n';
 
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
-    }
-    return 0;
-}
-int R()
-{
-    int i, j;
-    for (i = 1; i <= 5; i++)
-    {
-        for (j = 1; j <= 5; j++)
+        size_t line_length = (size_t)(out - line);
+        for (int copy = 1; copy < scale; copy++)
         {
-            if (j == 1 || i == 3 && j == 2 || j == 3 && i == 2 || j == 4 && i == 1 || i == 4 && j == 3 || i == 5 && j == 4 || i == 1 && j == 2 || i == 1 && j == 3 || i == 1 && j == 4)
-            {
-                printf(" *");
-            }
-
-            else
-            {
-                printf("  ");
-            }
+            memcpy(out, line, line_length);
+            out += line_length;
         }
-        printf("\n");
     }
-    return 0;
-}
-int S()
-{
-    int i, j;
-    for (i = 1; i <= 5; i++)
-    {
-        for (j = 1; j <= 5; j++)
-        {
-            if (i == 1 || i == 3 || i == 5 || j == 1 && i == 2 || j == 5 && i == 4)
-            {
-                printf(" *");
-            }
 
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
-    }
-    return 0;
-}
-int T()
-{
-    int i, j;
-    for (i = 1; i <= 5; i++)
+    if (colored)
     {
-        for (j = 1; j <= 5; j++)
-        {
-            if (i == 1 || j == 3)
-            {
-                printf(" *");
-            }
-
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
+        memcpy(out, RESET, strlen(RESET));
+        out += strlen(RESET);
     }
-    return 0;
+    return (size_t)(out - buffer);
 }
-int U()
+
+/*
+ * Draws text as a banner on fd with a single write. The banner is built in
+ * a buffer kept between calls, which only grows when a banner is larger
+ * than any before it. Returns SUCCESS, ERROR_INVALID_INPUT for an empty
+ * banner or bad scale, ERROR_MEMORY_ALLOCATION or ERROR_FILE_OPERATION.
+ */
+int writeBanner(int fd, const char *text, int scale, char fill_char, const char *color)
 {
-    int i, j;
-    for (i = 1; i <= 5; i++)
+    static char *buffer = NULL;
+    static size_t capacity = 0;
+
+    size_t size = bannerSize(text, scale, color);
+    if (size == 0)
+        return ERROR_INVALID_INPUT;
+    if (size > capacity)
     {
-        for (j = 1; j <= 5; j++)
+        free(buffer);
+        capacity = size > 2 * capacity ? size : 2 * capacity;
+        buffer = (char *)malloc(capacity);
+        if (buffer == NULL)
         {
-            if (i == 5 || j == 1 || j == 5)
-            {
-                printf(" *");
-            }
-            else
-            {
-                printf("  ");
-            }
+            capacity = 0;
+            return ERROR_MEMORY_ALLOCATION;
         }
-        printf("\n");
     }
-    return 0;
-}
-int V()
-{
-    int i, j;
-    for (i = 1; i <= 5; i++)
-    {
-        for (j = 1; j <= 5; j++)
-        {
-            if (i == 1 && j == 1 || i == 1 && j == 5 || j == 2 && i == 3 || j == 3 && i == 4 || j == 4 && i == 3)
-            {
-                printf(" *");
-            }
 
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
-    }
-    return 0;
-}
-int W()
-{
-    int i, j;
-    for (i = 1; i <= 5; i++)
-    {
-        for (j = 1; j <= 5; j++)
-        {
-            if (j == 1 || j == 5 || i == 4 && j == 2 || i == 4 && j == 4 || i == 3 && j == 3)
-            {
-                printf(" *");
-            }
+    PERF_REGION_BEGIN(banner);
+    size_t length = composeBanner(buffer, text, scale, fill_char, color);
+    PERF_REGION_END(banner);
 
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
-    }
-    return 0;
-}
-int X()
-{
-    int i, j;
-    for (i = 1; i <= 5; i++)
+    if (fd == STDOUT_FILENO)
+        fflush(stdout);
+    for (size_t done = 0; done < length;)
     {
-        for (j = 1; j <= 5; j++)
-        {
-            if (i == j || i == 1 && j == 5 || i == 2 && j == 4 || j == 1 && i == 5 || i == 4 && j == 2)
-            {
-                printf(" *");
-            }
-
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
+        ssize_t written = write(fd, buffer + done, length - done);
+        if (written <= 0)
+            return ERROR_FILE_OPERATION;
+        done += (size_t)written;
     }
-    return 0;
+    return SUCCESS;
 }
-int Y()
-{
-    int i, j;
-    for (i = 1; i <= 5; i++)
-    {
-        for (j = 1; j <= 5; j++)
-        {
-            if (i == 1 && j == 1 || i == 1 && j == 5 || i == 3 && j == 3 || i == 2 && j == 2 || i == 2 && j == 4 || j == 3 && i == 4 || j == 3 && i == 5)
-            {
-                printf(" *");
-            }
 
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
-    }
-    return 0;
-}
-int Z()
+/*
+ * Composes text as a banner straight into the sink's buffer. Returns SUCCESS,
+ * ERROR_INVALID_INPUT for an empty banner or bad scale, or
+ * ERROR_FILE_OPERATION once the sink has failed.
+ */
+int writeBannerTo(OutputSink *sink, const char *text, int scale, char fill_char, const char *color)
 {
-    int i, j;
-    for (i = 1; i <= 5; i++)
-    {
-        for (j = 1; j <= 5; j++)
-        {
-            if (i == 1 || i == 5 || i == 2 && j == 4 || i == 3 && j == 3 || i == 4 && j == 2)
-            {
-                printf(" *");
-            }
+    size_t size = bannerSize(text, scale, color);
+    if (size == 0)
+        return ERROR_INVALID_INPUT;
 
-            else
-            {
-                printf("  ");
-            }
-        }
-        printf("\n");
-    }
-    return 0;
-}
-void red()
-{
-    printf("\033[1;31m");
+    PERF_REGION_BEGIN(banner);
+    sinkCommit(sink, composeBanner(sinkReserve(sink, size), text, scale, fill_char, color));
+    PERF_REGION_END(banner);
+    return sink->error ? ERROR_FILE_OPERATION : SUCCESS;
 }
 
-void yellow()
+/* Draws text as a banner on stdout (spliced when it is a pipe); color may be NULL */
+int renderBanner(const char *text, int scale, char fill_char, const char *color)
 {
-    printf("\033[1;33m");
+    OutputSink sink;
+    if (sinkOpenStdout(&sink, SINK_SPLICE) != 0)
+        return ERROR_MEMORY_ALLOCATION;
+
+    int result = writeBannerTo(&sink, text, scale, fill_char, color);
+    if (sinkClose(&sink) != 0 && result == SUCCESS)
+        result = ERROR_FILE_OPERATION;
+    return result;
 }
 
-void reset()
+#ifndef BENCHMARK_BUILD
+static void yellow()
 {
-    printf("\033[0m");
+    printf("\033[1;33m");
 }
 
-int main()
+int main(int argc, char *argv[])
 {   
-    yellow();
-    R();
-    
-    printf("\n");
-    A();
+    if (argc > 1)
+        return renderBanner(argv[1], argc > 2 ? atoi(argv[2]) : 1, '*', "\033[1;33m") == SUCCESS ? 0 : 1;
 
-    printf("\n");
-    H();
-
-    printf("\n");
-    U();
-    printf("\n");
-    L();
-    // printf("\n");
-    // V();
-    return 0;
-}
\ No newline at end of file
+    OutputSink sink;
+    yellow();
+    if (sinkOpenStdout(&sink, SINK_SPLICE) != 0)
+        return 1;
+    writeWord(&sink, "RAHUL");
+    return sinkClose(&sink) == 0 ? 0 : 1;
+}
+#endif
\ No newline at end of file
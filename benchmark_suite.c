@@ -0,0 +1,547 @@
+/**
+ * @file benchmark_suite.c
+ * @brief Benchmarks the hot paths of the programs in this collection
+ * @version 1.0
+ * @date 2024
+ *
+ * Every benchmark is run over a sweep n = 10, 100, ... up to its own limit
+ * (and --max-n), and the results are printed as a table, CSV or JSON so
+ * that runs can be diffed over time.
+ *
+ * Compile: gcc -O3 -march=native -DBENCHMARK_BUILD -DPREMIUM_UTILS_NO_MAIN
+ *              benchmark_suite.c premium_utils.c bignum.c fibonacci_utils.c
+ *              factorial_utils.c range_sum_utils.c multiples_utils.c pass.c
+ *              recursive_digit_sum.c array_maximum.c half_pyramid.c
+ *              triangle_pattern.c hollow_square_pattern.c alphabet_patterns.c
+ *              pattern_utils.c output_sink.c -o benchmark_suite -pthread -lm
+ * Usage:   ./benchmark_suite [--format text|csv|json] [--max-n N]
+ *                            [--samples N] [--threads N] [--filter TEXT] [--list]
+ *                            [--progress]
+ *
+ * --progress replaces the per-case "running" lines on stderr with a
+ * progress line showing cases done, cases/s and an ETA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "premium_utils.h"
+#include "bignum.h"
+#include "fibonacci_utils.h"
+#include "factorial_utils.h"
+#include "range_sum_utils.h"
+#include "multiples_utils.h"
+#include "output_sink.h"
+
+/**
+ * @brief Entry points of the programs, built with -DBENCHMARK_BUILD
+ */
+int sumDigits(int no);
+int returnmax(int array[], int n);
+int pass_benchmark(const char *password, int threads);
+void printHalfPyramid(FILE *out, int rows);
+void printTriangle(FILE *out, int rows);
+void printHollowSquare(FILE *out, int n);
+void printWord(FILE *out, const char *word);
+int writeBanner(int fd, const char *text, int scale, char fill_char, const char *color);
+int writeHalfPyramid(OutputSink *sink, int rows);
+int writeBannerTo(OutputSink *sink, const char *text, int scale, char fill_char, const char *color);
+
+/**
+ * @brief Type for the state shared by one benchmark case
+ */
+typedef struct {
+    uint64_t n;
+    int threads;
+    BigNum big;
+    int *array;
+    char *text;
+    char password[16];
+    FILE *null_file;
+    BulkWriter null_writer;
+    MultiplesWheel wheel;
+    OutputSink memory_sink;
+} BenchCase;
+
+/**
+ * @brief Type for a registered benchmark
+ */
+typedef struct {
+    const char *name;
+    uint64_t max_n;                    /* largest n worth timing */
+    void (*setup)(BenchCase *bench);   /* may be NULL */
+    BenchFunction run;
+    int bytes_per_n;                   /* bytes processed per unit of n, for GB/s */
+} SuiteEntry;
+
+static const char *passwordCharset = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+/**
+ * @brief Fills an array with repeatable pseudo-random values
+ */
+static void setupArray(BenchCase *bench)
+{
+    uint32_t x = 12345;
+
+    bench->array = (int *)safeAlloc(bench->n * sizeof(int));
+    for (uint64_t i = 0; i < bench->n; i++)
+    {
+        x = x * 1103515245u + 12345u;
+        bench->array[i] = (int)(x >> 1);
+    }
+}
+
+/**
+ * @brief Picks the password pass.c finds after exactly n attempts
+ *
+ * Guesses are numbered in base 62 with the last character least
+ * significant, so guess n - 1 of the shortest length holding n guesses
+ * is the n-th one tried.
+ */
+static void setupPassword(BenchCase *bench)
+{
+    uint64_t index = bench->n - 1;
+    uint64_t keyspace = 62;
+    int length = 1;
+
+    while (keyspace < bench->n)
+    {
+        keyspace *= 62;
+        length++;
+    }
+    bench->password[length] = '\0';
+    for (int i = length - 1; i >= 0; i--)
+    {
+        bench->password[i] = passwordCharset[index % 62];
+        index /= 62;
+    }
+}
+
+/**
+ * @brief Builds an n letter word cycling through the alphabet
+ */
+static void setupWord(BenchCase *bench)
+{
+    bench->text = (char *)safeAlloc(bench->n + 1);
+    for (uint64_t i = 0; i < bench->n; i++)
+        bench->text[i] = (char)('A' + i % 26);
+    bench->text[bench->n] = '\0';
+}
+
+/**
+ * @brief Opens a memory sink, so only rendering into its buffer is timed
+ */
+static void setupMemorySink(BenchCase *bench)
+{
+    sinkOpenMemory(&bench->memory_sink, SINK_DEFAULT_CAPACITY);
+}
+
+static void setupWordSink(BenchCase *bench)
+{
+    setupWord(bench);
+    setupMemorySink(bench);
+}
+
+/**
+ * @brief Builds an n byte mixed-case palindrome for the string kernels
+ */
+static void setupPalindrome(BenchCase *bench)
+{
+    selectStringKernel(NULL);
+    bench->text = (char *)safeAlloc(bench->n + 1);
+    for (uint64_t i = 0; i < (bench->n + 1) / 2; i++)
+    {
+        bench->text[i] = (char)('a' + i % 26);
+        bench->text[bench->n - 1 - i] = (char)('A' + i % 26);
+    }
+    bench->text[bench->n] = '\0';
+}
+
+static void setupPalindromeScalar(BenchCase *bench)
+{
+    setupPalindrome(bench);
+    selectStringKernel("scalar");
+}
+
+static void setupWheel(BenchCase *bench)
+{
+    const uint64_t divisors[] = {3, 7};
+    wheelInit(&bench->wheel, divisors, 2);
+}
+
+static void benchFibonacci(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    fibonacci(&bench->big, bench->n);
+    DO_NOT_OPTIMIZE(bench->big.size);
+}
+
+static void benchFibonacciSequence(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    FibonacciSequence seq;
+
+    fibonacciSequenceInit(&seq);
+    for (uint64_t i = 0; i < bench->n; i++)
+    {
+        const BigNum *term = fibonacciSequenceNext(&seq);
+        DO_NOT_OPTIMIZE(term->size);
+    }
+    fibonacciSequenceFree(&seq);
+}
+
+static void benchFactorial(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    factorial(&bench->big, (uint32_t)bench->n);
+    DO_NOT_OPTIMIZE(bench->big.size);
+}
+
+static void benchSumRange(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    UInt128 sum = sumRange(1, bench->n);
+    DO_NOT_OPTIMIZE(sum);
+}
+
+static void benchSumPowers(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    sumPowers(&bench->big, 1, bench->n, 3);
+    DO_NOT_OPTIMIZE(bench->big.size);
+}
+
+static int isOdd(uint64_t i, void *ctx)
+{
+    (void)ctx;
+    return (int)(i & 1);
+}
+
+static void benchSumRangeIf(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    UInt128 sum = sumRangeIf(1, bench->n, isOdd, NULL, bench->threads);
+    DO_NOT_OPTIMIZE(sum);
+}
+
+/**
+ * @brief Checks sumRangeIf() against a plain loop before anything is timed
+ *
+ * Includes ranges with more threads than numbers, which once left slices
+ * past the end of the range.
+ * @return 0 if every sum matches, -1 otherwise
+ */
+static int checkSumRangeIf(int threads)
+{
+    static const uint64_t ranges[][2] = {{0, 0}, {0, 4}, {1, 10}, {5, 7}, {3, 1000}};
+
+    for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); r++)
+    {
+        UInt128 expected = 0;
+        for (uint64_t i = ranges[r][0]; i <= ranges[r][1]; i++)
+            expected += isOdd(i, NULL) ? i : 0;
+
+        for (int t = 1; t <= threads + 8; t++)
+        {
+            if (sumRangeIf(ranges[r][0], ranges[r][1], isOdd, NULL, t) != expected)
+            {
+                fprintf(stderr, "sumRangeIf(%llu, %llu) is wrong with %d threads\n",
+                        (unsigned long long)ranges[r][0], (unsigned long long)ranges[r][1], t);
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+static void benchMultiplesCount(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    uint64_t count = wheelCount(&bench->wheel, 0, bench->n);
+    DO_NOT_OPTIMIZE(count);
+}
+
+static void benchMultiplesWrite(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    wheelWrite(&bench->wheel, 0, bench->n, &bench->null_writer, " \n");
+    bulkWriterFlush(&bench->null_writer);
+}
+
+static void benchDigitSum(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    int sum = sumDigits((int)bench->n);
+    DO_NOT_OPTIMIZE(sum);
+}
+
+static void benchReturnMax(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    int max = returnmax(bench->array, (int)bench->n);
+    DO_NOT_OPTIMIZE(max);
+}
+
+static void benchFindMax(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    int max = findMax(bench->array, (int)bench->n);
+    DO_NOT_OPTIMIZE(max);
+}
+
+static void benchArrayStats(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    ArrayStats stats;
+    arrayStats(bench->array, bench->n, &stats);
+    DO_NOT_OPTIMIZE(stats.sum);
+}
+
+static void benchStreamStats(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    const double quantiles[] = {0.5, 0.99};
+    StreamStats stats;
+    streamStatsInit(&stats, quantiles, 2);
+    streamStatsAddArray(&stats, bench->array, bench->n);
+    DO_NOT_OPTIMIZE(stats.mean);
+}
+
+static void benchPalindrome(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    int result = isPalindromeN(bench->text, bench->n);
+    DO_NOT_OPTIMIZE(result);
+}
+
+static void benchReverse(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    reverseStringN(bench->text, bench->n);
+    CLOBBER_MEMORY();
+}
+
+static void benchPass(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    int result = pass_benchmark(bench->password, bench->threads);
+    DO_NOT_OPTIMIZE(result);
+}
+
+static void benchHalfPyramid(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    printHalfPyramid(bench->null_file, (int)bench->n);
+    fflush(bench->null_file);
+}
+
+static void benchTriangle(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    printTriangle(bench->null_file, (int)bench->n);
+    fflush(bench->null_file);
+}
+
+static void benchHollowSquare(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    printHollowSquare(bench->null_file, (int)bench->n);
+    fflush(bench->null_file);
+}
+
+static void benchHalfPyramidSink(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    sinkReset(&bench->memory_sink);
+    writeHalfPyramid(&bench->memory_sink, (int)bench->n);
+}
+
+static void benchAlphabet(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    printWord(bench->null_file, bench->text);
+    fflush(bench->null_file);
+}
+
+static void benchBanner(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    writeBanner(bench->null_writer.fd, bench->text, 1, '*', NULL);
+}
+
+static void benchBannerSink(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    sinkReset(&bench->memory_sink);
+    writeBannerTo(&bench->memory_sink, bench->text, 1, '*', NULL);
+}
+
+static void benchHistory(void *ctx)
+{
+    BenchCase *bench = (BenchCase *)ctx;
+    for (uint64_t i = 0; i < bench->n; i++)
+        addToHistory("benchmark operation");
+}
+
+/**
+ * @brief All benchmarks, in the order they are run
+ */
+static const SuiteEntry suite[] = {
+    {"fibonacci", 1000000, NULL, benchFibonacci, 0},
+    {"fibonacci_sequence", 100000, NULL, benchFibonacciSequence, 0},
+    {"factorial", 100000, NULL, benchFactorial, 0},
+    {"sum_range", 1000000000, NULL, benchSumRange, 0},
+    {"sum_cubes", 1000000000, NULL, benchSumPowers, 0},
+    {"sum_odd_predicate", 10000000, NULL, benchSumRangeIf, 0},
+    {"multiples_count", 1000000000, setupWheel, benchMultiplesCount, 0},
+    {"multiples_write", 10000000, setupWheel, benchMultiplesWrite, 0},
+    {"recursive_digit_sum", 1000000000, NULL, benchDigitSum, 0},
+    {"array_maximum", 10000000, setupArray, benchReturnMax, sizeof(int)},
+    {"find_max", 10000000, setupArray, benchFindMax, sizeof(int)},
+    {"array_stats", 100000000, setupArray, benchArrayStats, sizeof(int)},
+    {"stream_stats", 10000000, setupArray, benchStreamStats, sizeof(int)},
+    {"palindrome", 100000000, setupPalindrome, benchPalindrome, 1},
+    {"palindrome_scalar", 100000000, setupPalindromeScalar, benchPalindrome, 1},
+    {"reverse_string", 100000000, setupPalindrome, benchReverse, 1},
+    {"reverse_string_scalar", 100000000, setupPalindromeScalar, benchReverse, 1},
+    {"pass", 100000000, setupPassword, benchPass, 0},
+    {"half_pyramid", 10000, NULL, benchHalfPyramid, 0},
+    {"half_pyramid_sink", 10000, setupMemorySink, benchHalfPyramidSink, 0},
+    {"triangle_pattern", 10000, NULL, benchTriangle, 0},
+    {"hollow_square_pattern", 10000, NULL, benchHollowSquare, 0},
+    {"alphabet_patterns", 10000, setupWord, benchAlphabet, 0},
+    {"alphabet_banner", 100000, setupWord, benchBanner, 60},
+    {"alphabet_banner_sink", 100000, setupWordSink, benchBannerSink, 60},
+    {"history_add", 1000000, NULL, benchHistory, 0},
+};
+
+#define SUITE_SIZE ((int)(sizeof(suite) / sizeof(suite[0])))
+
+int main(int argc, char *argv[])
+{
+    BenchFormat format = BENCH_FORMAT_TEXT;
+    uint64_t max_n = 1000000000ULL;
+    int samples = 0;
+    int threads = 1;
+    const char *filter = NULL;
+    int show_progress = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--format") == 0 && i + 1 < argc)
+        {
+            i++;
+            if (strcmp(argv[i], "csv") == 0)
+                format = BENCH_FORMAT_CSV;
+            else if (strcmp(argv[i], "json") == 0)
+                format = BENCH_FORMAT_JSON;
+            else
+                format = BENCH_FORMAT_TEXT;
+        }
+        else if (strcmp(argv[i], "--max-n") == 0 && i + 1 < argc)
+            max_n = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc)
+            samples = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+            filter = argv[++i];
+        else if (strcmp(argv[i], "--progress") == 0)
+            show_progress = 1;
+        else if (strcmp(argv[i], "--list") == 0)
+        {
+            for (int b = 0; b < SUITE_SIZE; b++)
+                printf("%-24s n = 10..%llu\n", suite[b].name, (unsigned long long)suite[b].max_n);
+            return 0;
+        }
+        else
+        {
+            showHelp(argv[0], "Benchmarks the programs in this collection",
+                     "[--format text|csv|json] [--max-n N] [--samples N] [--threads N] [--filter TEXT] [--list] [--progress]");
+            return 1;
+        }
+    }
+
+    if (checkSumRangeIf(threads) != 0)
+        return 1;
+
+    int null_fd = open("/dev/null", O_WRONLY);
+    FILE *null_file = fopen("/dev/null", "w");
+    if (null_fd < 0 || null_file == NULL)
+    {
+        printError(ERROR_FILE_OPERATION);
+        return 1;
+    }
+    setvbuf(null_file, NULL, _IOFBF, 1 << 16);
+    bigNumSetThreads(threads);
+
+    int capacity = 16;
+    int count = 0;
+    BenchResult *results = (BenchResult *)safeAlloc(capacity * sizeof(BenchResult));
+
+    ProgressReporter progress;
+    uint64_t cases = 0;
+    for (int b = 0; b < SUITE_SIZE; b++)
+        if (filter == NULL || strstr(suite[b].name, filter) != NULL)
+            for (uint64_t n = 10; n <= suite[b].max_n && n <= max_n; n *= 10)
+                cases++;
+    progressInit(&progress, "benchmarks", "cases", cases, 0);
+    if (show_progress && progressStart(&progress) != SUCCESS)
+        show_progress = 0;
+
+    for (int b = 0; b < SUITE_SIZE; b++)
+    {
+        const SuiteEntry *entry = &suite[b];
+        if (filter != NULL && strstr(entry->name, filter) == NULL)
+            continue;
+
+        for (uint64_t n = 10; n <= entry->max_n && n <= max_n; n *= 10)
+        {
+            BenchCase bench;
+            char name[64];
+
+            memset(&bench, 0, sizeof(bench));
+            bench.n = n;
+            bench.threads = threads;
+            bench.null_file = null_file;
+            bigNumInit(&bench.big);
+            bulkWriterInit(&bench.null_writer, null_fd, 1 << 16);
+            if (entry->setup != NULL)
+                entry->setup(&bench);
+
+            snprintf(name, sizeof(name), "%s/%llu", entry->name, (unsigned long long)n);
+            if (!show_progress)
+                fprintf(stderr, "running %s\n", name);
+
+            if (count == capacity)
+            {
+                BenchResult *grown = (BenchResult *)safeAlloc(2 * capacity * sizeof(BenchResult));
+                memcpy(grown, results, count * sizeof(BenchResult));
+                free(results);
+                results = grown;
+                capacity *= 2;
+            }
+            runBenchmark(name, entry->run, &bench, samples, &results[count]);
+            results[count++].bytes_per_call = (double)entry->bytes_per_n * (double)n;
+
+            bigNumFree(&bench.big);
+            bulkWriterFree(&bench.null_writer);
+            wheelFree(&bench.wheel);
+            free(bench.array);
+            free(bench.text);
+            sinkClose(&bench.memory_sink);
+            progressAdd(&progress, 1);
+        }
+    }
+    progressStop(&progress);
+
+    printBenchmarkResults(stdout, results, count, format);
+
+    free(results);
+    fclose(null_file);
+    close(null_fd);
+    return 0;
+}
@@ -0,0 +1,488 @@
+/**
+ * @file bignum.c
+ * @brief Arbitrary-precision unsigned integers
+ * @version 1.0
+ * @date 2024
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "bignum.h"
+
+/**
+ * @brief Makes room for at least capacity limbs, keeping the current value
+ * @param n Number to grow
+ * @param capacity Limbs needed
+ */
+static void bigNumReserve(BigNum *n, size_t capacity)
+{
+    if (capacity <= n->capacity)
+        return;
+
+    size_t grown = n->capacity * 2;
+    if (grown < capacity)
+        grown = capacity;
+
+    uint32_t *limbs = (uint32_t *)realloc(n->limbs, grown * sizeof(uint32_t));
+    if (limbs == NULL)
+    {
+        printf("Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    n->limbs = limbs;
+    n->capacity = grown;
+}
+
+/**
+ * @brief Drops leading zero limbs
+ * @param n Number to normalize
+ */
+static void bigNumTrim(BigNum *n)
+{
+    while (n->size > 0 && n->limbs[n->size - 1] == 0)
+        n->size--;
+}
+
+void bigNumInit(BigNum *n)
+{
+    n->limbs = NULL;
+    n->size = 0;
+    n->capacity = 0;
+}
+
+void bigNumFree(BigNum *n)
+{
+    free(n->limbs);
+    bigNumInit(n);
+}
+
+void bigNumSetU64(BigNum *n, uint64_t value)
+{
+    bigNumReserve(n, 3);
+    n->size = 0;
+    while (value > 0)
+    {
+        n->limbs[n->size++] = (uint32_t)(value % BIGNUM_BASE);
+        value /= BIGNUM_BASE;
+    }
+}
+
+void bigNumCopy(BigNum *dst, const BigNum *src)
+{
+    if (dst == src)
+        return;
+    bigNumReserve(dst, src->size);
+    if (src->size > 0)
+        memcpy(dst->limbs, src->limbs, src->size * sizeof(uint32_t));
+    dst->size = src->size;
+}
+
+void bigNumSwap(BigNum *a, BigNum *b)
+{
+    BigNum temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+int bigNumCompare(const BigNum *a, const BigNum *b)
+{
+    if (a->size != b->size)
+        return a->size < b->size ? -1 : 1;
+
+    for (size_t i = a->size; i-- > 0;)
+    {
+        if (a->limbs[i] != b->limbs[i])
+            return a->limbs[i] < b->limbs[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+void bigNumAdd(BigNum *r, const BigNum *a, const BigNum *b)
+{
+    if (a->size < b->size)
+    {
+        const BigNum *temp = a;
+        a = b;
+        b = temp;
+    }
+
+    /* a and b may be r itself, so read their sizes before growing r */
+    size_t a_size = a->size, b_size = b->size;
+    bigNumReserve(r, a_size + 1);
+
+    uint32_t carry = 0;
+    for (size_t i = 0; i < a_size; i++)
+    {
+        uint32_t sum = a->limbs[i] + (i < b_size ? b->limbs[i] : 0) + carry;
+        carry = sum >= BIGNUM_BASE;
+        r->limbs[i] = carry ? sum - BIGNUM_BASE : sum;
+    }
+    r->size = a_size;
+    if (carry)
+        r->limbs[r->size++] = carry;
+}
+
+void bigNumSub(BigNum *r, const BigNum *a, const BigNum *b)
+{
+    size_t a_size = a->size, b_size = b->size;
+    bigNumReserve(r, a_size);
+
+    int32_t borrow = 0;
+    for (size_t i = 0; i < a_size; i++)
+    {
+        int64_t diff = (int64_t)a->limbs[i] - (i < b_size ? b->limbs[i] : 0) - borrow;
+        borrow = diff < 0;
+        r->limbs[i] = (uint32_t)(borrow ? diff + BIGNUM_BASE : diff);
+    }
+    r->size = a_size;
+    bigNumTrim(r);
+}
+
+void bigNumMulSmall(BigNum *r, const BigNum *a, uint32_t m)
+{
+    size_t a_size = a->size;
+    bigNumReserve(r, a_size + 2);
+
+    uint64_t carry = 0;
+    for (size_t i = 0; i < a_size; i++)
+    {
+        uint64_t product = (uint64_t)a->limbs[i] * m + carry;
+        r->limbs[i] = (uint32_t)(product % BIGNUM_BASE);
+        carry = product / BIGNUM_BASE;
+    }
+    r->size = a_size;
+    while (carry > 0)
+    {
+        r->limbs[r->size++] = (uint32_t)(carry % BIGNUM_BASE);
+        carry /= BIGNUM_BASE;
+    }
+    bigNumTrim(r);
+}
+
+uint32_t bigNumDivSmall(BigNum *r, const BigNum *a, uint32_t d)
+{
+    size_t a_size = a->size;
+    bigNumReserve(r, a_size);
+
+    uint64_t remainder = 0;
+    for (size_t i = a_size; i-- > 0;)
+    {
+        uint64_t cur = remainder * BIGNUM_BASE + a->limbs[i];
+        r->limbs[i] = (uint32_t)(cur / d);
+        remainder = cur % d;
+    }
+    r->size = a_size;
+    bigNumTrim(r);
+    return (uint32_t)remainder;
+}
+
+/**
+ * @brief Operand size (in limbs) below which schoolbook multiplication wins
+ */
+#define KARATSUBA_THRESHOLD 40
+
+/**
+ * @brief Operand size above which Karatsuba runs its sub-products on threads
+ */
+#define PARALLEL_THRESHOLD 2000
+
+/**
+ * @brief Helper threads multiplication may still start
+ */
+static atomic_int g_spareThreads = 0;
+
+void bigNumSetThreads(int threads)
+{
+    atomic_store(&g_spareThreads, threads > 1 ? threads - 1 : 0);
+}
+
+/**
+ * @brief Takes one helper thread from the pool
+ * @return 1 if a thread may be started, 0 otherwise
+ */
+int bigNumClaimThread(void)
+{
+    int spare = atomic_load(&g_spareThreads);
+    while (spare > 0)
+    {
+        if (atomic_compare_exchange_weak(&g_spareThreads, &spare, spare - 1))
+            return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Returns a helper thread to the pool
+ */
+void bigNumReleaseThread(void)
+{
+    atomic_fetch_add(&g_spareThreads, 1);
+}
+
+/**
+ * @brief Allocates limbs or exits
+ */
+static uint32_t *allocLimbs(size_t count)
+{
+    uint32_t *limbs = (uint32_t *)malloc((count > 0 ? count : 1) * sizeof(uint32_t));
+    if (limbs == NULL)
+    {
+        printf("Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    return limbs;
+}
+
+/**
+ * @brief dst[0..size) += src[0..src_size), propagating the carry through dst
+ */
+static void addLimbs(uint32_t *dst, size_t size, const uint32_t *src, size_t src_size)
+{
+    uint32_t carry = 0;
+    size_t i = 0;
+    for (; i < src_size; i++)
+    {
+        uint32_t sum = dst[i] + src[i] + carry;
+        carry = sum >= BIGNUM_BASE;
+        dst[i] = carry ? sum - BIGNUM_BASE : sum;
+    }
+    for (; carry && i < size; i++)
+    {
+        uint32_t sum = dst[i] + 1;
+        carry = sum >= BIGNUM_BASE;
+        dst[i] = carry ? 0 : sum;
+    }
+}
+
+/**
+ * @brief dst[0..size) -= src[0..src_size), for dst >= src
+ */
+static void subLimbs(uint32_t *dst, size_t size, const uint32_t *src, size_t src_size)
+{
+    uint32_t borrow = 0;
+    size_t i = 0;
+    for (; i < src_size; i++)
+    {
+        uint32_t sub = src[i] + borrow;
+        borrow = dst[i] < sub;
+        dst[i] = borrow ? dst[i] + BIGNUM_BASE - sub : dst[i] - sub;
+    }
+    for (; borrow && i < size; i++)
+    {
+        borrow = dst[i] == 0;
+        dst[i] = borrow ? BIGNUM_BASE - 1 : dst[i] - 1;
+    }
+}
+
+/**
+ * @brief Schoolbook product of two limb arrays
+ * @param out Result limbs, a_size + b_size of them, must not overlap the inputs
+ */
+static void mulSchoolbook(uint32_t *out, const uint32_t *a, size_t a_size,
+                          const uint32_t *b, size_t b_size)
+{
+    memset(out, 0, (a_size + b_size) * sizeof(uint32_t));
+    for (size_t i = 0; i < a_size; i++)
+    {
+        uint64_t carry = 0;
+        uint64_t ai = a[i];
+        for (size_t j = 0; j < b_size; j++)
+        {
+            uint64_t cur = out[i + j] + ai * b[j] + carry;
+            out[i + j] = (uint32_t)(cur % BIGNUM_BASE);
+            carry = cur / BIGNUM_BASE;
+        }
+        out[i + b_size] = (uint32_t)carry;
+    }
+}
+
+static void mulKaratsuba(uint32_t *out, const uint32_t *a, const uint32_t *b, size_t n);
+
+/**
+ * @brief Arguments for a Karatsuba sub-product run on a helper thread
+ */
+typedef struct {
+    uint32_t *out;
+    const uint32_t *a;
+    const uint32_t *b;
+    size_t n;
+} MulTask;
+
+static void *mulTaskRun(void *arg)
+{
+    MulTask *task = (MulTask *)arg;
+    mulKaratsuba(task->out, task->a, task->b, task->n);
+    return NULL;
+}
+
+/**
+ * @brief Karatsuba product of two n-limb arrays
+ *
+ * With a = a1*B^h + a0 and b = b1*B^h + b0:
+ *   a*b = z2*B^2h + (z1 - z2 - z0)*B^h + z0
+ * where z0 = a0*b0, z2 = a1*b1 and z1 = (a0 + a1)*(b0 + b1). On large
+ * operands z0 runs on a helper thread while this thread does z2 and z1.
+ *
+ * @param out Result limbs, 2n of them, must not overlap the inputs
+ */
+static void mulKaratsuba(uint32_t *out, const uint32_t *a, const uint32_t *b, size_t n)
+{
+    if (n < KARATSUBA_THRESHOLD)
+    {
+        mulSchoolbook(out, a, n, b, n);
+        return;
+    }
+
+    size_t h = n / 2;
+    size_t hi = n - h;
+
+    MulTask low = {out, a, b, h};
+    pthread_t helper;
+    int threaded = n >= PARALLEL_THRESHOLD && bigNumClaimThread();
+    if (threaded && pthread_create(&helper, NULL, mulTaskRun, &low) != 0)
+    {
+        bigNumReleaseThread();
+        threaded = 0;
+    }
+    if (!threaded)
+        mulKaratsuba(out, a, b, h);
+    mulKaratsuba(out + 2 * h, a + h, b + h, hi);
+
+    /* sums of the halves, hi + 1 limbs each */
+    uint32_t *sa = allocLimbs(2 * (hi + 1) + 2 * (hi + 1));
+    uint32_t *sb = sa + hi + 1;
+    uint32_t *z1 = sb + hi + 1;
+    memcpy(sa, a + h, hi * sizeof(uint32_t));
+    memcpy(sb, b + h, hi * sizeof(uint32_t));
+    sa[hi] = sb[hi] = 0;
+    addLimbs(sa, hi + 1, a, h);
+    addLimbs(sb, hi + 1, b, h);
+    mulKaratsuba(z1, sa, sb, hi + 1);
+
+    if (threaded)
+    {
+        pthread_join(helper, NULL);
+        bigNumReleaseThread();
+    }
+
+    subLimbs(z1, 2 * (hi + 1), out, 2 * h);
+    subLimbs(z1, 2 * (hi + 1), out + 2 * h, 2 * hi);
+    addLimbs(out + h, 2 * n - h, z1, 2 * (hi + 1) < 2 * n - h ? 2 * (hi + 1) : 2 * n - h);
+    free(sa);
+}
+
+/**
+ * @brief Product of two limb arrays of any sizes
+ *
+ * The longer operand is cut into pieces as long as the shorter one, so each
+ * piece is a balanced Karatsuba product.
+ *
+ * @param out Result limbs, a_size + b_size of them, must not overlap the inputs
+ */
+static void mulLimbs(uint32_t *out, const uint32_t *a, size_t a_size,
+                     const uint32_t *b, size_t b_size)
+{
+    if (a_size < b_size)
+    {
+        const uint32_t *t = a;
+        a = b;
+        b = t;
+        size_t ts = a_size;
+        a_size = b_size;
+        b_size = ts;
+    }
+
+    if (b_size < KARATSUBA_THRESHOLD)
+    {
+        mulSchoolbook(out, a, a_size, b, b_size);
+        return;
+    }
+    if (a_size == b_size)
+    {
+        mulKaratsuba(out, a, b, a_size);
+        return;
+    }
+
+    uint32_t *piece = allocLimbs(2 * b_size);
+    memset(out, 0, (a_size + b_size) * sizeof(uint32_t));
+    for (size_t offset = 0; offset < a_size; offset += b_size)
+    {
+        size_t length = a_size - offset < b_size ? a_size - offset : b_size;
+        if (length == b_size)
+            mulKaratsuba(piece, a + offset, b, b_size);
+        else
+            mulLimbs(piece, a + offset, length, b, b_size);
+        addLimbs(out + offset, a_size + b_size - offset, piece, length + b_size);
+    }
+    free(piece);
+}
+
+void bigNumMul(BigNum *r, const BigNum *a, const BigNum *b)
+{
+    if (a->size == 0 || b->size == 0)
+    {
+        r->size = 0;
+        return;
+    }
+
+    BigNum product;
+    bigNumInit(&product);
+    bigNumReserve(&product, a->size + b->size);
+    mulLimbs(product.limbs, a->limbs, a->size, b->limbs, b->size);
+    product.size = a->size + b->size;
+    bigNumTrim(&product);
+
+    bigNumSwap(r, &product);
+    bigNumFree(&product);
+}
+
+size_t bigNumDecimalLength(const BigNum *n)
+{
+    if (n->size == 0)
+        return 1;
+
+    size_t length = (n->size - 1) * BIGNUM_BASE_DIGITS;
+    for (uint32_t top = n->limbs[n->size - 1]; top > 0; top /= 10)
+        length++;
+    return length;
+}
+
+size_t bigNumToString(const BigNum *n, char *buffer)
+{
+    if (n->size == 0)
+    {
+        strcpy(buffer, "0");
+        return 1;
+    }
+
+    size_t length = sprintf(buffer, "%u", n->limbs[n->size - 1]);
+    for (size_t i = n->size - 1; i-- > 0;)
+    {
+        /* every lower limb is exactly BIGNUM_BASE_DIGITS digits, zero-padded */
+        uint32_t limb = n->limbs[i];
+        for (int d = BIGNUM_BASE_DIGITS - 1; d >= 0; d--)
+        {
+            buffer[length + d] = (char)('0' + limb % 10);
+            limb /= 10;
+        }
+        length += BIGNUM_BASE_DIGITS;
+    }
+    buffer[length] = '\0';
+    return length;
+}
+
+void bigNumPrint(FILE *fp, const BigNum *n)
+{
+    char *buffer = (char *)malloc(bigNumDecimalLength(n) + 1);
+    if (buffer == NULL)
+    {
+        printf("Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    size_t length = bigNumToString(n, buffer);
+    fwrite(buffer, 1, length, fp);
+    free(buffer);
+}
@@ -0,0 +1,157 @@
+/**
+ * @file bignum.h
+ * @brief Arbitrary-precision unsigned integers
+ * @version 1.0
+ * @date 2024
+ *
+ * Numbers are stored as base 10^9 limbs, least significant first, so
+ * printing in decimal is a single linear pass over the limbs.
+ */
+
+#ifndef BIGNUM_H
+#define BIGNUM_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Limb base and the number of decimal digits per limb
+ */
+#define BIGNUM_BASE 1000000000u
+#define BIGNUM_BASE_DIGITS 9
+
+/**
+ * @brief Type for an arbitrary-precision unsigned integer
+ */
+typedef struct {
+    uint32_t *limbs;  /* base BIGNUM_BASE digits, least significant first */
+    size_t size;      /* limbs in use, 0 for the value zero */
+    size_t capacity;  /* limbs allocated */
+} BigNum;
+
+/**
+ * @brief Initializes a number to zero
+ * @param n Number to initialize
+ */
+void bigNumInit(BigNum *n);
+
+/**
+ * @brief Releases the memory held by a number
+ * @param n Number to free
+ */
+void bigNumFree(BigNum *n);
+
+/**
+ * @brief Sets a number from a 64-bit value
+ * @param n Number to set
+ * @param value Value to store
+ */
+void bigNumSetU64(BigNum *n, uint64_t value);
+
+/**
+ * @brief Copies a number
+ * @param dst Destination
+ * @param src Source
+ */
+void bigNumCopy(BigNum *dst, const BigNum *src);
+
+/**
+ * @brief Exchanges two numbers without copying their limbs
+ * @param a First number
+ * @param b Second number
+ */
+void bigNumSwap(BigNum *a, BigNum *b);
+
+/**
+ * @brief Compares two numbers
+ * @param a First number
+ * @param b Second number
+ * @return Negative, zero or positive as a is less than, equal to or greater than b
+ */
+int bigNumCompare(const BigNum *a, const BigNum *b);
+
+/**
+ * @brief Computes r = a + b (r may alias a or b)
+ * @param r Result
+ * @param a First operand
+ * @param b Second operand
+ */
+void bigNumAdd(BigNum *r, const BigNum *a, const BigNum *b);
+
+/**
+ * @brief Computes r = a - b for a >= b (r may alias a or b)
+ * @param r Result
+ * @param a First operand
+ * @param b Second operand, not greater than a
+ */
+void bigNumSub(BigNum *r, const BigNum *a, const BigNum *b);
+
+/**
+ * @brief Computes r = a * m (r may alias a)
+ * @param r Result
+ * @param a Number to multiply
+ * @param m Small multiplier
+ */
+void bigNumMulSmall(BigNum *r, const BigNum *a, uint32_t m);
+
+/**
+ * @brief Computes r = a / d, rounding down (r may alias a)
+ * @param r Result
+ * @param a Number to divide
+ * @param d Small non-zero divisor
+ * @return The remainder a % d
+ */
+uint32_t bigNumDivSmall(BigNum *r, const BigNum *a, uint32_t d);
+
+/**
+ * @brief Computes r = a * b (r may alias a or b)
+ *
+ * Uses Karatsuba multiplication on large operands, spreading the biggest
+ * products over the threads allowed by bigNumSetThreads().
+ * @param r Result
+ * @param a First operand
+ * @param b Second operand
+ */
+void bigNumMul(BigNum *r, const BigNum *a, const BigNum *b);
+
+/**
+ * @brief Sets how many threads large multiplications may use in total
+ * @param threads Thread count (1, the default, keeps everything on the caller)
+ */
+void bigNumSetThreads(int threads);
+
+/**
+ * @brief Takes a thread from the pool set by bigNumSetThreads()
+ * @return 1 if the caller may start one more thread, 0 otherwise
+ */
+int bigNumClaimThread(void);
+
+/**
+ * @brief Returns a thread taken with bigNumClaimThread()
+ */
+void bigNumReleaseThread(void);
+
+/**
+ * @brief Counts the decimal digits of a number
+ * @param n Number to measure
+ * @return Number of digits (1 for zero)
+ */
+size_t bigNumDecimalLength(const BigNum *n);
+
+/**
+ * @brief Writes a number in decimal
+ * @param n Number to convert
+ * @param buffer Buffer of at least bigNumDecimalLength(n) + 1 bytes
+ * @return Number of characters written, excluding the terminator
+ */
+size_t bigNumToString(const BigNum *n, char *buffer);
+
+/**
+ * @brief Prints a number in decimal
+ * @param fp Stream to print to
+ * @param n Number to print
+ */
+void bigNumPrint(FILE *fp, const BigNum *n);
+
+#endif /* BIGNUM_H */
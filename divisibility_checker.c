@@ -1,16 +1,29 @@
 #include <stdio.h>
-void main(){
-    int a,b;
-    printf("enter a number: ");
-    scanf("%d",&a);
-    for(b=0;b<=a;b++){
-        if(b%3==0){
-            printf("%d \n",b);
+#include <string.h>
+#include <unistd.h>
+#include "multiples_utils.h"
 
-        }
-        else if(b%7==0){
-            printf("%d \n",b);
-        }
+/* Compile: gcc divisibility_checker.c multiples_utils.c -o divisibility_checker */
+/* Run with --count to print only how many numbers match */
+int main(int argc,char *argv[]){
+    long long a;
+    uint64_t divisors[]={3,7};
+    MultiplesWheel wheel;
+    BulkWriter out;
+    printf("enter a number: ");
+    if(scanf("%lld",&a)!=1||a<0){
+        return 0;
+    }
+    wheelInit(&wheel,divisors,2);
+    if(argc>1&&strcmp(argv[1],"--count")==0){
+        printf("%llu\n",(unsigned long long)wheelCount(&wheel,0,(uint64_t)a));
+    }
+    else{
+        fflush(stdout);
+        bulkWriterInit(&out,STDOUT_FILENO,1<<16);
+        wheelWrite(&wheel,0,(uint64_t)a,&out," \n");
+        bulkWriterFree(&out);
     }
-    
+    wheelFree(&wheel);
+    return 0;
 }
\ No newline at end of file
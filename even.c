@@ -1,12 +1,29 @@
 #include <stdio.h>
-int main(){
-    int num,i;
+#include <string.h>
+#include <unistd.h>
+#include "multiples_utils.h"
+
+/* Compile: gcc even.c multiples_utils.c -o even */
+/* Run with --count to print only how many even numbers there are */
+int main(int argc,char *argv[]){
+    long long num;
+    uint64_t divisors[]={2};
+    MultiplesWheel wheel;
+    BulkWriter out;
     printf("enter a number to print even numbers till:");
-    scanf("%d",&num);
-    for(i=1;i<=num;i++){
-        if(i%2==0){
-            printf("%d\n",i);
-        }
+    if(scanf("%lld",&num)!=1||num<1){
+        return 0;
     }
+    wheelInit(&wheel,divisors,1);
+    if(argc>1&&strcmp(argv[1],"--count")==0){
+        printf("%llu\n",(unsigned long long)wheelCount(&wheel,1,(uint64_t)num));
+    }
+    else{
+        fflush(stdout);
+        bulkWriterInit(&out,STDOUT_FILENO,1<<16);
+        wheelWrite(&wheel,1,(uint64_t)num,&out,"\n");
+        bulkWriterFree(&out);
+    }
+    wheelFree(&wheel);
     return 0;
 }
\ No newline at end of file
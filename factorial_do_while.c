@@ -1,14 +1,22 @@
 #include <stdio.h>
+#include <unistd.h>
+#include "factorial_utils.h"
+
+/* Compile: gcc factorial_do_while.c factorial_utils.c bignum.c -o factorial_do_while -pthread */
 int main(){
-    int i=1,n,fac=1;
-    printf("enter a random number");
-    scanf("%d",&n);
+    long long n;
+    BigNum fac;
     do
     {
-       fac*=i;
-        /* code */
-        i++;
-    } while (i<=n);
-    printf("the factorial of %d is %d",n,fac);
+        printf("enter a random number");
+        if (scanf("%lld",&n) != 1)
+            return 1;
+    } while (n<0 || n>UINT32_MAX - 1);
+    bigNumSetThreads((int)sysconf(_SC_NPROCESSORS_ONLN));
+    bigNumInit(&fac);
+    factorial(&fac,(uint32_t)n);
+    printf("the factorial of %lld is ",n);
+    bigNumPrint(stdout,&fac);
+    bigNumFree(&fac);
 return 0;
 }
\ No newline at end of file
@@ -1,10 +1,25 @@
 #include <stdio.h>
+#include <unistd.h>
+#include "factorial_utils.h"
+
+/* Compile: gcc factorial_for_loop.c factorial_utils.c bignum.c -o factorial_for_loop -pthread */
 int main(){
-     int  number, i,factor=1;
+    long long number;
+    BigNum factor;
     printf("Enter a number to print its factorial: ");
-    scanf("%d", &number);
-    for(i=1; i<=number; i++)
-    factor=factor*i;
-    printf("The factorial of %d is %d", number, factor);
+    if (scanf("%lld", &number) != 1 || number < 0) {
+        printf("Please enter a non-negative number.\n");
+        return 1;
+    }
+    if (number > UINT32_MAX - 1) {
+        printf("Please enter a number no larger than %lu.\n", (unsigned long)(UINT32_MAX - 1));
+        return 1;
+    }
+    bigNumSetThreads((int)sysconf(_SC_NPROCESSORS_ONLN));
+    bigNumInit(&factor);
+    factorial(&factor, (uint32_t)number);
+    printf("The factorial of %lld is ", number);
+    bigNumPrint(stdout, &factor);
+    bigNumFree(&factor);
     return 0;
 }
\ No newline at end of file
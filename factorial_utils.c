@@ -0,0 +1,95 @@
+/**
+ * @file factorial_utils.c
+ * @brief Exact factorials of any size
+ * @version 1.0
+ * @date 2024
+ */
+
+#include <pthread.h>
+#include "factorial_utils.h"
+
+/**
+ * @brief Ranges with fewer factors than this are multiplied out directly
+ */
+#define LEAF_FACTORS 32
+
+/**
+ * @brief Ranges with more factors than this may split across threads
+ */
+#define PARALLEL_FACTORS 4096
+
+/**
+ * @brief Arguments for a half of the product tree run on a helper thread
+ */
+typedef struct {
+    BigNum *result;
+    uint32_t lo;
+    uint32_t hi;
+} RangeTask;
+
+static void *rangeTaskRun(void *arg)
+{
+    RangeTask *task = (RangeTask *)arg;
+    productRange(task->result, task->lo, task->hi);
+    return NULL;
+}
+
+/**
+ * @brief Multiplies out a short range, packing factors into 32-bit words
+ */
+static void productLeaf(BigNum *result, uint32_t lo, uint32_t hi)
+{
+    uint64_t word = 1;
+
+    bigNumSetU64(result, 1);
+    for (uint32_t i = lo; i < hi; i++)
+    {
+        if (word * i > UINT32_MAX)
+        {
+            bigNumMulSmall(result, result, (uint32_t)word);
+            word = 1;
+        }
+        word *= i;
+    }
+    bigNumMulSmall(result, result, (uint32_t)word);
+}
+
+void productRange(BigNum *result, uint32_t lo, uint32_t hi)
+{
+    if (hi <= lo + LEAF_FACTORS)
+    {
+        productLeaf(result, lo, hi);
+        return;
+    }
+
+    uint32_t mid = lo + (hi - lo) / 2;
+    BigNum left, right;
+    bigNumInit(&left);
+    bigNumInit(&right);
+
+    RangeTask task = {&left, lo, mid};
+    pthread_t helper;
+    int threaded = hi - lo >= PARALLEL_FACTORS && bigNumClaimThread();
+    if (threaded && pthread_create(&helper, NULL, rangeTaskRun, &task) != 0)
+    {
+        bigNumReleaseThread();
+        threaded = 0;
+    }
+    if (!threaded)
+        productRange(&left, lo, mid);
+    productRange(&right, mid, hi);
+    if (threaded)
+    {
+        pthread_join(helper, NULL);
+        bigNumReleaseThread();
+    }
+
+    bigNumMul(result, &left, &right);
+    bigNumFree(&left);
+    bigNumFree(&right);
+}
+
+void factorial(BigNum *result, uint32_t n)
+{
+    productRange(result, 2, n + 1);
+}
@@ -0,0 +1,35 @@
+/**
+ * @file factorial_utils.h
+ * @brief Exact factorials of any size
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef FACTORIAL_UTILS_H
+#define FACTORIAL_UTILS_H
+
+#include <stdint.h>
+#include "bignum.h"
+
+/**
+ * @brief Computes n! exactly
+ *
+ * The product 1*2*...*n is split into a balanced binary tree so that the
+ * expensive multiplications are between numbers of similar size, where
+ * Karatsuba pays off. The two halves of the top levels of the tree run on
+ * separate threads when bigNumSetThreads() allows it.
+ *
+ * @param result Receives n!
+ * @param n Number to take the factorial of
+ */
+void factorial(BigNum *result, uint32_t n);
+
+/**
+ * @brief Computes the product lo * (lo+1) * ... * (hi-1)
+ * @param result Receives the product (1 when lo >= hi)
+ * @param lo First factor
+ * @param hi One past the last factor
+ */
+void productRange(BigNum *result, uint32_t lo, uint32_t hi);
+
+#endif /* FACTORIAL_UTILS_H */
@@ -1,21 +1,61 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include "fibonacci_utils.h"
 
-int main()
+/* Largest N for --nth: F(10^7) has about 2.1 million digits and takes seconds */
+#define NTH_MAX 10000000ULL
+
+/*
+ * Prints the first n Fibonacci terms, or with --nth N just F(N).
+ * Terms are exact at any size and only the last two are kept in memory.
+ *
+ * Compile: gcc fibbonacci.c fibonacci_utils.c bignum.c -o fibbonacci
+ */
+int main(int argc, char *argv[])
 {
-    int n;
-    printf("enter the value of n (n<2): ");
-    scanf("%d", &n);
-    
-    int fib[n];
-    fib[0] = 0;
-    fib[1] = 1;
-    printf("%d\t%d\t", fib[0], fib[1]);
-    for (int i = 2; i < n; i++)
+    long long n;
+
+    if (argc == 3 && strcmp(argv[1], "--nth") == 0)
+    {
+        BigNum term;
+        char *end;
+        unsigned long long nth;
+
+        errno = 0;
+        nth = strtoull(argv[2], &end, 10);
+        if (!isdigit((unsigned char)argv[2][0]) || *end != '\0' || errno == ERANGE || nth > NTH_MAX)
+        {
+            printf("N must be a whole number from 0 to %llu\n", NTH_MAX);
+            return 1;
+        }
+        bigNumInit(&term);
+        fibonacci(&term, nth);
+        bigNumPrint(stdout, &term);
+        printf("\n");
+        bigNumFree(&term);
+        return 0;
+    }
+
+    printf("enter the value of n (n>=2): ");
+    if (scanf("%lld", &n) != 1 || n < 2)
     {
-        fib[i] = fib[i - 1] + fib[i - 2];
-        printf("%d \t", fib[i]);
+        printf("n must be at least 2\n");
+        return 1;
     }
-    
+
+    FibonacciSequence seq;
+    fibonacciSequenceInit(&seq);
+    printf("0\t");
+    for (long long i = 1; i < n; i++)
+    {
+        bigNumPrint(stdout, fibonacciSequenceNext(&seq));
+        printf(i == 1 ? "\t" : " \t");
+    }
+    fibonacciSequenceFree(&seq);
+
     printf("\n");
 
     return 0;
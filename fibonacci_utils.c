@@ -0,0 +1,90 @@
+/**
+ * @file fibonacci_utils.c
+ * @brief Fibonacci numbers of any size
+ * @version 1.0
+ * @date 2024
+ */
+
+#include "fibonacci_utils.h"
+
+/**
+ * @brief Computes F(n) by fast doubling
+ *
+ * With a = F(k) and b = F(k+1):
+ *   F(2k)   = a * (2b - a)
+ *   F(2k+1) = a^2 + b^2
+ * The bits of n are consumed from the top, doubling k at each step and
+ * adding one when the bit is set.
+ */
+void fibonacci(BigNum *result, uint64_t n)
+{
+    BigNum a, b, c, d, t;
+    bigNumInit(&a);
+    bigNumInit(&b);
+    bigNumInit(&c);
+    bigNumInit(&d);
+    bigNumInit(&t);
+
+    bigNumSetU64(&a, 0);
+    bigNumSetU64(&b, 1);
+
+    int bit = 63;
+    while (bit >= 0 && !((n >> bit) & 1))
+        bit--;
+
+    for (; bit >= 0; bit--)
+    {
+        /* c = a * (2b - a) */
+        bigNumAdd(&t, &b, &b);
+        bigNumSub(&t, &t, &a);
+        bigNumMul(&c, &a, &t);
+
+        /* d = a^2 + b^2 */
+        bigNumMul(&d, &a, &a);
+        bigNumMul(&t, &b, &b);
+        bigNumAdd(&d, &d, &t);
+
+        if ((n >> bit) & 1)
+        {
+            bigNumAdd(&c, &c, &d);
+            bigNumSwap(&a, &d);
+            bigNumSwap(&b, &c);
+        }
+        else
+        {
+            bigNumSwap(&a, &c);
+            bigNumSwap(&b, &d);
+        }
+    }
+
+    bigNumSwap(result, &a);
+    bigNumFree(&a);
+    bigNumFree(&b);
+    bigNumFree(&c);
+    bigNumFree(&d);
+    bigNumFree(&t);
+}
+
+void fibonacciSequenceInit(FibonacciSequence *seq)
+{
+    bigNumInit(&seq->current);
+    bigNumInit(&seq->next);
+    bigNumSetU64(&seq->current, 0);
+    bigNumSetU64(&seq->next, 1);
+    seq->index = 0;
+}
+
+const BigNum *fibonacciSequenceNext(FibonacciSequence *seq)
+{
+    /* (current, next) becomes (next, current + next) in place */
+    bigNumAdd(&seq->current, &seq->current, &seq->next);
+    bigNumSwap(&seq->current, &seq->next);
+    seq->index++;
+    return &seq->current;
+}
+
+void fibonacciSequenceFree(FibonacciSequence *seq)
+{
+    bigNumFree(&seq->current);
+    bigNumFree(&seq->next);
+}
@@ -0,0 +1,52 @@
+/**
+ * @file fibonacci_utils.h
+ * @brief Fibonacci numbers of any size
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef FIBONACCI_UTILS_H
+#define FIBONACCI_UTILS_H
+
+#include <stdint.h>
+#include "bignum.h"
+
+/**
+ * @brief Type for a streaming Fibonacci sequence generator
+ *
+ * Only the last two terms are kept, so walking the sequence uses memory
+ * proportional to the size of the current term, not the number of terms.
+ */
+typedef struct {
+    BigNum current;  /* F(index) */
+    BigNum next;     /* F(index + 1) */
+    uint64_t index;
+} FibonacciSequence;
+
+/**
+ * @brief Computes F(n) by fast doubling in O(log n) multiplications
+ * @param result Receives F(n)
+ * @param n Index of the term (F(0) = 0, F(1) = 1)
+ */
+void fibonacci(BigNum *result, uint64_t n);
+
+/**
+ * @brief Starts a sequence at F(0)
+ * @param seq Sequence to initialize
+ */
+void fibonacciSequenceInit(FibonacciSequence *seq);
+
+/**
+ * @brief Advances a sequence by one term
+ * @param seq Sequence to advance
+ * @return The new current term, valid until the next call
+ */
+const BigNum *fibonacciSequenceNext(FibonacciSequence *seq);
+
+/**
+ * @brief Releases a sequence
+ * @param seq Sequence to free
+ */
+void fibonacciSequenceFree(FibonacciSequence *seq);
+
+#endif /* FIBONACCI_UTILS_H */
@@ -1,58 +1,49 @@
 #include <stdio.h>
-void red()
-{
-    printf("\033[1;31m");
-}
-
-void yellow()
-{
-    printf("\033[1;33m");
-}
-
-void green()
-{
-    printf("\033[1;32m");
-}
-
-void blue()
-{
-    printf("\033[1;34m");
-}
-
-void cyan()
-{
-    printf("\033[1;36m");
-}
-
-void magenta()
+#include <stdlib.h>
+#include <string.h>
+#include "premium_utils.h"
+#include "pattern_utils.h"
+
+/* Compile: gcc half_pyramid.c pattern_utils.c output_sink.c -o half_pyramid -pthread (add -DPERF_COUNTERS=1 -DPREMIUM_UTILS_NO_MAIN premium_utils.c -lm for hardware counters) */
+/* Usage:   ./half_pyramid [ROWS [OUTPUT_FILE [--direct]]]  (asks for ROWS when not given) */
+void printHalfPyramid(FILE *out, int rows){
+    PERF_REGION_BEGIN(half_pyramid);
+    patternPrint(out,PATTERN_HALF_PYRAMID,rows);
+    PERF_REGION_END(half_pyramid);
+}
+int writeHalfPyramid(OutputSink *sink, int rows){
+    int result;
+    PERF_REGION_BEGIN(half_pyramid);
+    result=patternWriteSink(sink,PATTERN_HALF_PYRAMID,rows);
+    PERF_REGION_END(half_pyramid);
+    return result;
+}
+#ifndef BENCHMARK_BUILD
+static void magenta()
 {
     printf("\033[1;35m");
 }
 
-void white()
-{
-    printf("\033[1;37m");
-}
-
-void black()
-{
-    printf("\033[1;30m");
-}
-
-void reset()
-{
-    printf("\033[0m");
-}
-int main() {
-    int i;int j;int rows;
+int main(int argc, char *argv[]) {
+    int rows;
+    OutputSink sink;
+    if(argc>2){
+        if(sinkOpenFile(&sink,argv[2],argc>3&&strcmp(argv[3],"--direct")==0?SINK_DIRECT:0)!=0)
+            return 1;
+        writeHalfPyramid(&sink,atoi(argv[1]));
+        return sinkClose(&sink)==0?0:1;
+    }
     magenta();
-    printf("Enter the number of rows: ");
-    scanf("%d", &rows);
-    for(i=0;i<rows;i++){
-        for(j=0;j<=i;j++){
-            printf("* ");
-        }
-        printf("\n");
+    if(argc>1){
+        rows=atoi(argv[1]);
+    }
+    else{
+        printf("Enter the number of rows: ");
+        scanf("%d", &rows);
     }
+    sinkOpenStdout(&sink,SINK_SPLICE);
+    writeHalfPyramid(&sink,rows);
+    sinkClose(&sink);
     return 0;
 }
+#endif
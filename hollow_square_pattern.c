@@ -1,20 +1,43 @@
 #include <stdio.h>
-int main(){
-    int i,j,n;
-    printf("enter a random number");
-    scanf("%d",&n);
-    int m=n;
-    for(i=1;i<=n;i++){
-        for(j=1;j<=n;j++){
-            if(i==1||j==1||i==m||j==m){
-                printf("S ");
-        }
-        else{
-            printf("  ");    
-                }
-    }
-    printf("\n");
+#include <stdlib.h>
+#include <string.h>
+#include "premium_utils.h"
+#include "pattern_utils.h"
 
+/* Compile: gcc hollow_square_pattern.c pattern_utils.c output_sink.c -o hollow_square_pattern -pthread (add -DPERF_COUNTERS=1 -DPREMIUM_UTILS_NO_MAIN premium_utils.c -lm for hardware counters) */
+/* Usage:   ./hollow_square_pattern [N [OUTPUT_FILE [--direct]]]  (asks for N when not given) */
+void printHollowSquare(FILE *out, int n){
+    PERF_REGION_BEGIN(hollow_square);
+    patternPrint(out,PATTERN_HOLLOW_SQUARE,n);
+    PERF_REGION_END(hollow_square);
+}
+int writeHollowSquare(OutputSink *sink, int n){
+    int result;
+    PERF_REGION_BEGIN(hollow_square);
+    result=patternWriteSink(sink,PATTERN_HOLLOW_SQUARE,n);
+    PERF_REGION_END(hollow_square);
+    return result;
 }
+#ifndef BENCHMARK_BUILD
+int main(int argc, char *argv[]){
+    int n;
+    OutputSink sink;
+    if(argc>2){
+        if(sinkOpenFile(&sink,argv[2],argc>3&&strcmp(argv[3],"--direct")==0?SINK_DIRECT:0)!=0)
+            return 1;
+        writeHollowSquare(&sink,atoi(argv[1]));
+        return sinkClose(&sink)==0?0:1;
+    }
+    if(argc>1){
+        n=atoi(argv[1]);
+    }
+    else{
+        printf("enter a random number");
+        scanf("%d",&n);
+    }
+    sinkOpenStdout(&sink,SINK_SPLICE);
+    writeHollowSquare(&sink,n);
+    sinkClose(&sink);
 return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,235 @@
+/**
+ * @file multiples_utils.c
+ * @brief Enumerating and counting multiples of a set of divisors
+ * @version 1.0
+ * @date 2024
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "multiples_utils.h"
+
+/**
+ * @brief Allocates memory or exits
+ */
+static void *allocOrExit(size_t size)
+{
+    void *ptr = malloc(size > 0 ? size : 1);
+    if (ptr == NULL)
+    {
+        printf("Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    return ptr;
+}
+
+static uint64_t gcd(uint64_t a, uint64_t b)
+{
+    while (b != 0)
+    {
+        uint64_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+int wheelInit(MultiplesWheel *wheel, const uint64_t *divisors, int num_divisors)
+{
+    uint64_t period = 1;
+
+    wheel->offsets = NULL;
+    wheel->count = 0;
+    wheel->period = 0;
+
+    for (int i = 0; i < num_divisors; i++)
+    {
+        if (divisors[i] == 0)
+            return -1;
+        period = period / gcd(period, divisors[i]) * divisors[i];
+        if (period > WHEEL_MAX_PERIOD)
+            return -1;
+    }
+
+    /* mark each divisor's residue class by stepping, not by testing */
+    unsigned char *hit = (unsigned char *)calloc(period, 1);
+    if (hit == NULL)
+    {
+        printf("Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < num_divisors; i++)
+    {
+        for (uint64_t x = 0; x < period; x += divisors[i])
+            hit[x] = 1;
+    }
+
+    size_t count = 0;
+    for (uint64_t x = 0; x < period; x++)
+        count += hit[x];
+
+    wheel->offsets = (uint32_t *)allocOrExit(count * sizeof(uint32_t));
+    for (uint64_t x = 0; x < period; x++)
+    {
+        if (hit[x])
+            wheel->offsets[wheel->count++] = (uint32_t)x;
+    }
+    wheel->period = period;
+    free(hit);
+    return 0;
+}
+
+void wheelFree(MultiplesWheel *wheel)
+{
+    free(wheel->offsets);
+    wheel->offsets = NULL;
+    wheel->count = 0;
+}
+
+/**
+ * @brief Index of the first offset >= residue
+ */
+static size_t firstOffsetAtLeast(const MultiplesWheel *wheel, uint64_t residue)
+{
+    size_t lo = 0, hi = wheel->count;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (wheel->offsets[mid] < residue)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * @brief Counts the multiples in 0..x
+ */
+static uint64_t countUpTo(const MultiplesWheel *wheel, uint64_t x)
+{
+    return (x / wheel->period) * wheel->count + firstOffsetAtLeast(wheel, x % wheel->period + 1);
+}
+
+uint64_t wheelCount(const MultiplesWheel *wheel, uint64_t lo, uint64_t hi)
+{
+    if (hi < lo || wheel->count == 0)
+        return 0;
+    return countUpTo(wheel, hi) - (lo > 0 ? countUpTo(wheel, lo - 1) : 0);
+}
+
+uint64_t wheelWrite(const MultiplesWheel *wheel, uint64_t lo, uint64_t hi,
+                    BulkWriter *writer, const char *suffix)
+{
+    size_t suffix_length = strlen(suffix);
+    uint64_t written = 0;
+
+    if (hi < lo || wheel->count == 0)
+        return 0;
+
+    /* one division to find the starting spoke; after that only additions */
+    uint64_t base = lo / wheel->period * wheel->period;
+    size_t i = firstOffsetAtLeast(wheel, lo - base);
+
+    for (;;)
+    {
+        for (; i < wheel->count; i++)
+        {
+            uint64_t value = base + wheel->offsets[i];
+            if (value > hi || value < base)
+                return written;
+            bulkWriteU64(writer, value);
+            bulkWrite(writer, suffix, suffix_length);
+            written++;
+        }
+        if (base > UINT64_MAX - wheel->period)
+            return written;
+        base += wheel->period;
+        i = 0;
+    }
+}
+
+void bulkWriterInit(BulkWriter *writer, int fd, size_t capacity)
+{
+    if (capacity < 64)
+        capacity = 64;
+    writer->fd = fd;
+    writer->buffer = (char *)allocOrExit(capacity);
+    writer->used = 0;
+    writer->capacity = capacity;
+}
+
+int bulkWriterFlush(BulkWriter *writer)
+{
+    size_t done = 0;
+    while (done < writer->used)
+    {
+        ssize_t n = write(writer->fd, writer->buffer + done, writer->used - done);
+        if (n <= 0)
+            return -1;
+        done += (size_t)n;
+    }
+    writer->used = 0;
+    return 0;
+}
+
+void bulkWrite(BulkWriter *writer, const char *data, size_t length)
+{
+    if (writer->used + length > writer->capacity)
+    {
+        bulkWriterFlush(writer);
+        if (length > writer->capacity)
+        {
+            /* too big to buffer: hand it straight to the descriptor */
+            while (length > 0)
+            {
+                ssize_t n = write(writer->fd, data, length);
+                if (n <= 0)
+                    return;
+                data += n;
+                length -= (size_t)n;
+            }
+            return;
+        }
+    }
+    memcpy(writer->buffer + writer->used, data, length);
+    writer->used += length;
+}
+
+void bulkWriteU64(BulkWriter *writer, uint64_t value)
+{
+    static const char pairs[201] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    char digits[20];
+    int pos = 20;
+
+    /* two digits per division, written from the right */
+    while (value >= 100)
+    {
+        unsigned pair = (unsigned)(value % 100) * 2;
+        value /= 100;
+        digits[--pos] = pairs[pair + 1];
+        digits[--pos] = pairs[pair];
+    }
+    if (value >= 10)
+    {
+        digits[--pos] = pairs[value * 2 + 1];
+        digits[--pos] = pairs[value * 2];
+    }
+    else
+    {
+        digits[--pos] = (char)('0' + value);
+    }
+    bulkWrite(writer, digits + pos, 20 - pos);
+}
+
+void bulkWriterFree(BulkWriter *writer)
+{
+    bulkWriterFlush(writer);
+    free(writer->buffer);
+    writer->buffer = NULL;
+}
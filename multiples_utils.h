@@ -0,0 +1,114 @@
+/**
+ * @file multiples_utils.h
+ * @brief Enumerating and counting multiples of a set of divisors
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef MULTIPLES_UTILS_H
+#define MULTIPLES_UTILS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Largest wheel period (lcm of the divisors) wheelInit() accepts
+ */
+#define WHEEL_MAX_PERIOD (1u << 24)
+
+/**
+ * @brief Type for a wheel of multiples
+ *
+ * Whether x is a multiple of any divisor only depends on x mod lcm, so the
+ * residues that are (the union of the divisors' residue classes) are found
+ * once and then stepped through period by period with no modulo at all.
+ */
+typedef struct {
+    uint64_t period;    /* lcm of the divisors */
+    uint32_t *offsets;  /* matching residues in [0, period), ascending */
+    size_t count;       /* number of offsets */
+} MultiplesWheel;
+
+/**
+ * @brief Type for a buffered writer that emits large blocks with write()
+ */
+typedef struct {
+    int fd;
+    char *buffer;
+    size_t used;
+    size_t capacity;
+} BulkWriter;
+
+/**
+ * @brief Builds the wheel for a set of divisors
+ * @param wheel Wheel to initialize
+ * @param divisors Divisors (all non-zero)
+ * @param num_divisors Number of divisors
+ * @return 0 on success, -1 if a divisor is 0 or the lcm exceeds WHEEL_MAX_PERIOD
+ */
+int wheelInit(MultiplesWheel *wheel, const uint64_t *divisors, int num_divisors);
+
+/**
+ * @brief Releases a wheel
+ * @param wheel Wheel to free
+ */
+void wheelFree(MultiplesWheel *wheel);
+
+/**
+ * @brief Counts the multiples in lo..hi without enumerating them
+ * @param wheel Wheel to use
+ * @param lo First number
+ * @param hi Last number
+ * @return Number of multiples of any divisor in lo..hi
+ */
+uint64_t wheelCount(const MultiplesWheel *wheel, uint64_t lo, uint64_t hi);
+
+/**
+ * @brief Writes every multiple in lo..hi, each followed by suffix
+ * @param wheel Wheel to use
+ * @param lo First number
+ * @param hi Last number
+ * @param writer Writer to append to
+ * @param suffix Text written after each number (e.g. "\n")
+ * @return Number of multiples written
+ */
+uint64_t wheelWrite(const MultiplesWheel *wheel, uint64_t lo, uint64_t hi,
+                    BulkWriter *writer, const char *suffix);
+
+/**
+ * @brief Initializes a writer on a file descriptor
+ * @param writer Writer to initialize
+ * @param fd Descriptor to write to
+ * @param capacity Buffer size in bytes
+ */
+void bulkWriterInit(BulkWriter *writer, int fd, size_t capacity);
+
+/**
+ * @brief Appends bytes
+ * @param writer Writer to append to
+ * @param data Bytes to append
+ * @param length Number of bytes
+ */
+void bulkWrite(BulkWriter *writer, const char *data, size_t length);
+
+/**
+ * @brief Appends a number in decimal
+ * @param writer Writer to append to
+ * @param value Number to append
+ */
+void bulkWriteU64(BulkWriter *writer, uint64_t value);
+
+/**
+ * @brief Writes out everything buffered
+ * @param writer Writer to flush
+ * @return 0 on success, -1 on a write error
+ */
+int bulkWriterFlush(BulkWriter *writer);
+
+/**
+ * @brief Flushes and releases a writer
+ * @param writer Writer to free
+ */
+void bulkWriterFree(BulkWriter *writer);
+
+#endif /* MULTIPLES_UTILS_H */
@@ -1,15 +1,16 @@
 #include <stdio.h>
+#include "range_sum_utils.h"
+
+/* Compile: gcc natural_number_sum.c range_sum_utils.c bignum.c -o natural_number_sum -pthread */
 int main(){
-    int i,n,m;
-    int sum=0;
+    long long n,m;
+    char sum[41];
     printf("enter  a natural starting number");
-    scanf("%d",&n);
+    scanf("%lld",&n);
     printf("enter a  natural number");
-    scanf("%d",&m);
-    for(i=n;i<=m;i++){
-        sum=sum+i;
-    }
-    printf("the sum till %d to %d is %d",n,m,sum);
+    scanf("%lld",&m);
+    int128ToString(sumRangeSigned(n,m),sum);
+    printf("the sum till %lld to %lld is %s",n,m,sum);
     return 0;
 
 }
\ No newline at end of file
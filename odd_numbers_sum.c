@@ -1,14 +1,29 @@
 #include <stdio.h>
+#include <unistd.h>
+#include "premium_utils.h"
+#include "range_sum_utils.h"
+
+/* Compile: gcc -DPREMIUM_UTILS_NO_MAIN odd_numbers_sum.c range_sum_utils.c bignum.c premium_utils.c -o odd_numbers_sum -pthread -lm */
+/* When the numbers go to a file, progress and ETA are shown on stderr. */
 int main(){
-    int num,i,sum=0;
+    unsigned long long num,i,batch=0;
+    char sum[40];
+    ProgressReporter progress;
     printf("enter a number to print odd numbers till 1 to:");
-    scanf("%d",&num);
-    for(i=1;i<=num;i++){
-        if(i%2!=0){
-            printf("%d\n",i);
-            sum=sum+i;
+    scanf("%llu",&num);
+    progressInit(&progress,"odd numbers","numbers",num/2+num%2,0);
+    if(!isatty(STDOUT_FILENO)&&isatty(STDERR_FILENO))
+        progressStart(&progress);
+    for(i=1;i<=num;i+=2){
+        printf("%llu\n",i);
+        if(++batch==RANGE_PROGRESS_BATCH){
+            progressAdd(&progress,batch);
+            batch=0;
         }
     }
-    printf("the sum of odd numbers is %d",sum);
+    progressAdd(&progress,batch);
+    progressStop(&progress);
+    uint128ToString(sumOddUpTo(num),sum);
+    printf("the sum of odd numbers is %s",sum);
     return 0;
 }
\ No newline at end of file
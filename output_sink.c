@@ -0,0 +1,343 @@
+/**
+ * @file output_sink.c
+ * @brief Buffered output to stdout, files, pipes or memory
+ * @version 1.0
+ * @date 2024
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include "output_sink.h"
+
+/**
+ * @brief Maps a page-aligned buffer
+ *
+ * Buffers come straight from mmap() rather than malloc(): pages handed to
+ * a pipe by vmsplice() must never be reused for other data, and unmapping
+ * them leaves the pipe's references intact.
+ */
+static char *mapBuffer(size_t size)
+{
+    void *buffer = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return buffer == MAP_FAILED ? NULL : (char *)buffer;
+}
+
+static size_t roundUp(size_t size)
+{
+    return (size + SINK_ALIGNMENT - 1) / SINK_ALIGNMENT * SINK_ALIGNMENT;
+}
+
+/**
+ * @brief Writes all of data, retrying short writes
+ */
+static int writeAll(int fd, const char *data, size_t length)
+{
+    while (length > 0)
+    {
+        ssize_t n = write(fd, data, length);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return -1;
+        data += n;
+        length -= (size_t)n;
+    }
+    return 0;
+}
+
+/**
+ * @brief Turns O_DIRECT off, e.g. for the unaligned tail
+ */
+static void stopDirect(OutputSink *sink)
+{
+    int flags = fcntl(sink->fd, F_GETFL);
+    if (flags >= 0)
+        fcntl(sink->fd, F_SETFL, flags & ~O_DIRECT);
+    sink->direct = 0;
+}
+
+#ifdef __linux__
+/**
+ * @brief Sets the fd up for vmsplice() if it is a pipe
+ */
+static void startSplice(OutputSink *sink)
+{
+    struct stat st;
+
+    if (fstat(sink->fd, &st) != 0 || !S_ISFIFO(st.st_mode))
+        return;
+
+    fcntl(sink->fd, F_SETPIPE_SZ, SINK_PIPE_SIZE);
+    int size = fcntl(sink->fd, F_GETPIPE_SZ);
+    if (size <= 0)
+        return;
+
+    /*
+     * Two buffers of twice the pipe size, and only buffers holding at least
+     * a full pipe are spliced. Once all of one is in the pipe, everything
+     * spliced before it has been read, so the other buffer is free again.
+     */
+    size_t capacity = roundUp(2 * (size_t)size);
+    char *buffer = mapBuffer(capacity);
+    char *spare = mapBuffer(capacity);
+    if (buffer == NULL || spare == NULL)
+    {
+        if (buffer != NULL)
+            munmap(buffer, capacity);
+        if (spare != NULL)
+            munmap(spare, capacity);
+        return;
+    }
+
+    munmap(sink->buffer, sink->capacity);
+    sink->buffer = buffer;
+    sink->capacity = capacity;
+    sink->spare = spare;
+    sink->spare_capacity = capacity;
+    sink->pipe_size = (size_t)size;
+    sink->splice = 1;
+}
+
+/**
+ * @brief Splices the whole buffer into the pipe and switches to the spare
+ * @return 0 on success, 1 if vmsplice() is not supported, -1 on error
+ */
+static int spliceBuffer(OutputSink *sink)
+{
+    struct iovec iov = {sink->buffer, sink->used};
+
+    while (iov.iov_len > 0)
+    {
+        ssize_t n = vmsplice(sink->fd, &iov, 1, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0 && iov.iov_base == sink->buffer && (errno == EINVAL || errno == ENOSYS))
+            return 1;
+        if (n <= 0)
+            return -1;
+        iov.iov_base = (char *)iov.iov_base + n;
+        iov.iov_len -= (size_t)n;
+    }
+
+    char *buffer = sink->buffer;
+    size_t capacity = sink->capacity;
+    sink->buffer = sink->spare;
+    sink->capacity = sink->spare_capacity;
+    sink->spare = buffer;
+    sink->spare_capacity = capacity;
+    sink->used = 0;
+    return 0;
+}
+#else
+static void startSplice(OutputSink *sink)
+{
+    (void)sink;
+}
+
+static int spliceBuffer(OutputSink *sink)
+{
+    (void)sink;
+    return 1;
+}
+#endif
+
+/**
+ * @brief Hands the buffer to the fd
+ * @param final 1 to also write an O_DIRECT tail
+ */
+static int flushBuffer(OutputSink *sink, int final)
+{
+    if (sink->error)
+    {
+        sink->used = 0;
+        return -1;
+    }
+    if (sink->target == SINK_TARGET_MEMORY || sink->used == 0)
+        return 0;
+
+    if (sink->splice && sink->used >= sink->pipe_size)
+    {
+        int result = spliceBuffer(sink);
+        if (result <= 0)
+        {
+            sink->error = result < 0;
+            return result;
+        }
+        sink->splice = 0; /* not supported after all: write() from now on */
+    }
+
+    if (sink->direct)
+    {
+        size_t whole = sink->used / SINK_ALIGNMENT * SINK_ALIGNMENT;
+        if (whole > 0 && writeAll(sink->fd, sink->buffer, whole) != 0)
+        {
+            if (errno != EINVAL)
+            {
+                sink->error = 1;
+                return -1;
+            }
+            /* the file system refused O_DIRECT after all */
+            stopDirect(sink);
+            whole = 0;
+        }
+        memmove(sink->buffer, sink->buffer + whole, sink->used - whole);
+        sink->used -= whole;
+        if (!final || sink->used == 0)
+            return 0;
+        stopDirect(sink);
+    }
+
+    if (writeAll(sink->fd, sink->buffer, sink->used) != 0)
+    {
+        sink->error = 1;
+        return -1;
+    }
+    sink->used = 0;
+    return 0;
+}
+
+/**
+ * @brief Replaces the buffer with a bigger one, keeping its contents
+ */
+static int growBuffer(OutputSink *sink, size_t needed)
+{
+    size_t capacity = sink->capacity;
+    while (capacity < needed)
+        capacity *= 2;
+
+    char *buffer = mapBuffer(capacity);
+    if (buffer == NULL)
+        return -1;
+    memcpy(buffer, sink->buffer, sink->used);
+    munmap(sink->buffer, sink->capacity);
+    sink->buffer = buffer;
+    sink->capacity = capacity;
+    return 0;
+}
+
+static int openSink(OutputSink *sink, SinkTarget target, int fd, size_t capacity)
+{
+    memset(sink, 0, sizeof(*sink));
+    sink->target = target;
+    sink->fd = fd;
+    sink->capacity = roundUp(capacity > 0 ? capacity : SINK_ALIGNMENT);
+    sink->buffer = mapBuffer(sink->capacity);
+    return sink->buffer == NULL ? -1 : 0;
+}
+
+int sinkOpenFd(OutputSink *sink, int fd, int flags)
+{
+    if (openSink(sink, SINK_TARGET_FD, fd, SINK_DEFAULT_CAPACITY) != 0)
+        return -1;
+
+    if (flags & SINK_SPLICE)
+        startSplice(sink);
+
+    if ((flags & SINK_DIRECT) && !sink->splice)
+    {
+        /* O_DIRECT also needs the file offset on a block boundary */
+        off_t offset = lseek(fd, 0, SEEK_CUR);
+        int fd_flags = fcntl(fd, F_GETFL);
+        if (offset >= 0 && offset % SINK_ALIGNMENT == 0 && fd_flags >= 0 &&
+            fcntl(fd, F_SETFL, fd_flags | O_DIRECT) == 0)
+            sink->direct = 1;
+    }
+    return 0;
+}
+
+int sinkOpenStdout(OutputSink *sink, int flags)
+{
+    fflush(stdout);
+    return sinkOpenFd(sink, STDOUT_FILENO, flags);
+}
+
+int sinkOpenFile(OutputSink *sink, const char *path, int flags)
+{
+    /* read access too, so the file can be mapped by sinkIsPlainFd() users */
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return -1;
+
+    if (sinkOpenFd(sink, fd, flags) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    sink->owns_fd = 1;
+    return 0;
+}
+
+int sinkOpenMemory(OutputSink *sink, size_t capacity)
+{
+    return openSink(sink, SINK_TARGET_MEMORY, -1, capacity);
+}
+
+char *sinkReserve(OutputSink *sink, size_t length)
+{
+    if (sink->used + length > sink->capacity)
+    {
+        flushBuffer(sink, 0);
+        if (sink->used + length > sink->capacity && growBuffer(sink, sink->used + length) != 0)
+        {
+            printf("Memory allocation failed.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    return sink->buffer + sink->used;
+}
+
+void sinkCommit(OutputSink *sink, size_t length)
+{
+    sink->used += length;
+}
+
+int sinkWrite(OutputSink *sink, const void *data, size_t length)
+{
+    memcpy(sinkReserve(sink, length), data, length);
+    sinkCommit(sink, length);
+    return sink->error ? -1 : 0;
+}
+
+int sinkFlush(OutputSink *sink)
+{
+    return flushBuffer(sink, 0);
+}
+
+const char *sinkData(const OutputSink *sink, size_t *length)
+{
+    *length = sink->used;
+    return sink->buffer;
+}
+
+void sinkReset(OutputSink *sink)
+{
+    if (sink->target == SINK_TARGET_MEMORY)
+        sink->used = 0;
+}
+
+int sinkIsPlainFd(const OutputSink *sink)
+{
+    return sink->target == SINK_TARGET_FD && !sink->direct && !sink->splice && !sink->error;
+}
+
+int sinkClose(OutputSink *sink)
+{
+    int result = flushBuffer(sink, 1);
+
+    if (sink->buffer != NULL)
+        munmap(sink->buffer, sink->capacity);
+    if (sink->spare != NULL)
+        munmap(sink->spare, sink->spare_capacity);
+    if (sink->owns_fd && close(sink->fd) != 0)
+        result = -1;
+    memset(sink, 0, sizeof(*sink));
+    return result;
+}
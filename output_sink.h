@@ -0,0 +1,171 @@
+/**
+ * @file output_sink.h
+ * @brief Buffered output to stdout, files, pipes or memory
+ * @version 1.0
+ * @date 2024
+ *
+ * A sink owns a large page-aligned buffer. Renderers reserve space in it,
+ * draw straight into it and commit what they drew, so generated text is
+ * never copied on its way to the target. Full buffers go out with write(),
+ * with O_DIRECT for files (SINK_DIRECT) or with vmsplice() for pipes
+ * (SINK_SPLICE), where the pipe takes the buffer's pages instead of a copy.
+ */
+
+#ifndef OUTPUT_SINK_H
+#define OUTPUT_SINK_H
+
+#include <stddef.h>
+
+/**
+ * @brief Buffer alignment, and the block size O_DIRECT writes are made of
+ */
+#define SINK_ALIGNMENT 4096
+
+/**
+ * @brief Buffer size for file and stdout targets
+ */
+#define SINK_DEFAULT_CAPACITY (1 << 20)
+
+/**
+ * @brief Pipe size requested for SINK_SPLICE (the unprivileged maximum)
+ */
+#define SINK_PIPE_SIZE (1 << 20)
+
+/**
+ * @brief Flags for the sinkOpen*() functions
+ *
+ * Both are requests: a target that does not support them (a file system
+ * without O_DIRECT, an fd that is not a pipe) silently gets plain write().
+ */
+#define SINK_DIRECT 0x1  /* files: bypass the page cache with O_DIRECT */
+#define SINK_SPLICE 0x2  /* pipes: hand buffer pages to the pipe with vmsplice() */
+
+/**
+ * @brief Where a sink's output goes
+ */
+typedef enum {
+    SINK_TARGET_FD,
+    SINK_TARGET_MEMORY
+} SinkTarget;
+
+/**
+ * @brief Type for an output sink
+ */
+typedef struct {
+    SinkTarget target;
+    int fd;
+    int owns_fd;        /* opened by sinkOpenFile(), closed by sinkClose() */
+    int direct;         /* O_DIRECT is on: only whole SINK_ALIGNMENT blocks are written */
+    int splice;         /* fd is a pipe fed with vmsplice() */
+    char *buffer;       /* SINK_ALIGNMENT aligned */
+    size_t used;
+    size_t capacity;
+    char *spare;        /* splice: the buffer the pipe may still be reading */
+    size_t spare_capacity;
+    size_t pipe_size;   /* splice: only buffers at least this full are spliced */
+    int error;          /* set once a write fails; later output is dropped */
+} OutputSink;
+
+/**
+ * @brief Opens a sink on a file descriptor (left open by sinkClose())
+ * @param sink Sink to initialize
+ * @param fd Descriptor to write to
+ * @param flags SINK_DIRECT and/or SINK_SPLICE, or 0
+ * @return 0 on success, -1 if the buffer cannot be allocated
+ */
+int sinkOpenFd(OutputSink *sink, int fd, int flags);
+
+/**
+ * @brief Opens a sink on stdout, flushing what stdio holds first
+ * @param sink Sink to initialize
+ * @param flags SINK_DIRECT and/or SINK_SPLICE, or 0
+ * @return 0 on success, -1 if the buffer cannot be allocated
+ */
+int sinkOpenStdout(OutputSink *sink, int flags);
+
+/**
+ * @brief Creates or truncates a file and opens a sink on it
+ * @param sink Sink to initialize
+ * @param path File to write
+ * @param flags SINK_DIRECT and/or SINK_SPLICE, or 0
+ * @return 0 on success, -1 if the file cannot be opened
+ */
+int sinkOpenFile(OutputSink *sink, const char *path, int flags);
+
+/**
+ * @brief Opens a sink that collects its output in memory
+ * @param sink Sink to initialize
+ * @param capacity Initial size (the buffer grows as needed)
+ * @return 0 on success, -1 if the buffer cannot be allocated
+ */
+int sinkOpenMemory(OutputSink *sink, size_t capacity);
+
+/**
+ * @brief Gets room for length bytes at the end of the buffer
+ *
+ * Flushes or grows the buffer when needed. Draw into the returned space,
+ * then call sinkCommit() with the number of bytes actually used.
+ * @param sink Sink to reserve in
+ * @param length Bytes needed
+ * @return Pointer to at least length free bytes
+ */
+char *sinkReserve(OutputSink *sink, size_t length);
+
+/**
+ * @brief Adds bytes drawn after sinkReserve() to the output
+ * @param sink Sink to commit to
+ * @param length Bytes drawn
+ */
+void sinkCommit(OutputSink *sink, size_t length);
+
+/**
+ * @brief Copies bytes to the output
+ * @param sink Sink to write to
+ * @param data Bytes to write
+ * @param length Number of bytes
+ * @return 0 on success, -1 if the sink has failed
+ */
+int sinkWrite(OutputSink *sink, const void *data, size_t length);
+
+/**
+ * @brief Hands the buffered output to the target
+ *
+ * With O_DIRECT, a tail shorter than SINK_ALIGNMENT stays buffered until
+ * sinkClose(). Memory sinks have nothing to flush.
+ * @param sink Sink to flush
+ * @return 0 on success, -1 on a write error
+ */
+int sinkFlush(OutputSink *sink);
+
+/**
+ * @brief Gets the output a memory sink has collected
+ * @param sink Memory sink
+ * @param length Set to the number of bytes
+ * @return The bytes (valid until the next write or sinkClose())
+ */
+const char *sinkData(const OutputSink *sink, size_t *length);
+
+/**
+ * @brief Drops the output a memory sink has collected, keeping its buffer
+ * @param sink Memory sink
+ */
+void sinkReset(OutputSink *sink);
+
+/**
+ * @brief Tells whether a sink writes straight to an fd with plain write()
+ *
+ * Such a sink can be bypassed by code with a better way to reach the fd
+ * (e.g. mapping a file), after sinkFlush().
+ * @param sink Sink to check
+ * @return 1 for a plain descriptor sink, 0 otherwise
+ */
+int sinkIsPlainFd(const OutputSink *sink);
+
+/**
+ * @brief Flushes everything, releases the buffers and closes an owned file
+ * @param sink Sink to close
+ * @return 0 if all output was written, -1 otherwise
+ */
+int sinkClose(OutputSink *sink);
+
+#endif /* OUTPUT_SINK_H */
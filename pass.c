@@ -2,61 +2,1276 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <ctype.h>
-void bruteforce(char *password, int max_length)
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "premium_utils.h"
+
+/*
+ * Brute force password search.
+ *
+ * The keyspace of all guesses of a given length is numbered 0..keyspace-1
+ * (base 62, last character least significant). Worker threads claim
+ * CHUNK_SIZE wide index ranges from a shared atomic cursor until the
+ * keyspace is exhausted or one of them finds the password. Each range is
+ * expanded in batches of BATCH_SIZE candidates by a CandidateGen and the
+ * whole batch is handed to the matcher at once.
+ *
+ * With --max-length N all lengths 1..N are searched in increasing order.
+ * With --checkpoint FILE the progress (current length and keyspace offset)
+ * is written every --checkpoint-every million attempts, and an interrupted
+ * run started again with the same arguments resumes from it.
+ *
+ * Candidates are matched 16 (SSE2) or 32 (AVX2) at a time; the widest
+ * matcher the CPU supports is picked at startup, --matcher forces one and
+ * --bench-match prints candidates/s for each of them.
+ *
+ * With --hash fnv1a|sha256 the argument is a hex digest instead of a
+ * password: candidates are hashed in groups of HASH_LANES and compared
+ * against it (--max-length is required, --digest-of WORD prints a digest).
+ *
+ * --mask MASK (e.g. ?l?l?d?d) searches only guesses matching the mask, and
+ * --wordlist FILE tries each line of FILE instead of generated guesses. The
+ * wordlist is memory-mapped and claimed by the workers WORDLIST_CHUNK_SIZE
+ * bytes at a time, so it streams in constant memory however large it is.
+ *
+ * --progress prints guesses/s and an ETA on stderr while searching. Workers
+ * add each finished chunk to a shared counter that a reporter thread from
+ * premium_utils samples, so the search loop itself never prints.
+ *
+ * Compile: gcc -O3 -march=native -DPREMIUM_UTILS_NO_MAIN pass.c premium_utils.c
+ *          -o pass -pthread -lm
+ * (with -DBENCHMARK_BUILD main() is left out and pass_benchmark() is built
+ * instead, for benchmark_suite.c). Add -DPERF_COUNTERS=1 to print hardware
+ * counters for the search and for each matcher in --bench-match.
+ * Usage:   ./pass [--threads N] [--max-length N] [--checkpoint FILE]
+ *                 [--checkpoint-every MILLIONS] [--matcher scalar|sse2|avx2]
+ *                 [--bench-match] [--hash fnv1a|sha256] [--digest-of WORD]
+ *                 [--mask MASK | --wordlist FILE] [--progress]
+ *                 [password | digest]
+ */
+
+#define MAX_THREADS 256
+#define MAX_PASSWORD_LENGTH 10 /* 62^10 still fits in 64 bits */
+#define CHUNK_SIZE 65536
+#define WORDLIST_CHUNK_SIZE (1 << 20) /* bytes of wordlist claimed at a time */
+#define SLOT_SIZE 16 /* bytes per candidate in a batch, >= MAX_PASSWORD_LENGTH */
+#define BATCH_SIZE 256
+#define CACHE_LINE 64
+
+static const char *charset = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+typedef enum
+{
+    HASH_NONE, /* target is the plaintext password */
+    HASH_FNV1A64,
+    HASH_SHA256
+} HashKind;
+
+typedef struct
+{
+    int threads;
+    HashKind hash;
+    int min_length;
+    int max_length;
+    const char *mask;             /* e.g. "?l?l?d?d"; NULL for exhaustive search */
+    const char *wordlist_path;    /* dictionary attack instead of generated guesses */
+    const char *checkpoint_path;  /* NULL disables checkpointing */
+    uint64_t checkpoint_interval; /* attempts between checkpoint writes */
+    int quiet;                    /* skip the per-worker and summary report */
+    int progress;                 /* report throughput and ETA on stderr */
+} SearchOptions;
+
+/*
+ * On-disk checkpoint: every guess shorter than length, and every guess of
+ * that length below offset, has already been tried. In wordlist mode length
+ * is 0 and offset is a byte offset into the wordlist.
+ */
+typedef struct
+{
+    char magic[4];
+    uint32_t length;
+    uint64_t offset;
+} Checkpoint;
+
+typedef struct Worker Worker;
+
+typedef struct
 {
-    char *charset = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
-    int charset_size = strlen(charset);
-    int password_length = strlen(password);
-    char *guess = (char *)malloc(password_length + 1);
+    const char *password;
+    int password_length;
+    char target[SLOT_SIZE]; /* password zero-padded to one batch slot */
+    HashKind hash;
+    uint32_t target_digest[8]; /* hash mode: FNV uses words 0-1, SHA-256 all 8 */
+    int length;                            /* guess length of the current pass */
+    const char *sets[MAX_PASSWORD_LENGTH]; /* characters tried at each position */
+    uint64_t keyspace;                     /* guesses, or wordlist bytes, in this pass */
+    uint64_t chunk_size;
+    const char *words; /* mapped wordlist, NULL unless in wordlist mode */
+    atomic_uint_fast64_t next_index;
+    atomic_int found;
+    uint64_t found_index;
+    char result[MAX_PASSWORD_LENGTH + 1];
 
-    for (int i = 0; i < password_length; i++)
+    Worker *workers;
+    int threads;
+    const SearchOptions *options;
+    atomic_uint_fast64_t total_attempts;
+    atomic_uint_fast64_t next_checkpoint;
+    pthread_mutex_t checkpoint_lock;
+    ProgressReporter *progress; /* NULL unless --progress */
+} SearchState;
+
+struct Worker
+{
+    SearchState *state;
+    int id;
+    uint64_t attempts;
+    double seconds;
+    atomic_uint_fast64_t chunk_floor; /* no unfinished chunk of this worker starts below this */
+    pthread_t thread;
+    char pad[CACHE_LINE]; /* keep per-worker counters on separate cache lines */
+};
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+ * Candidate generator: an odometer over digit indices, with its own
+ * character set per position (the full charset for exhaustive search, or
+ * one set per mask position). successor[i][d] is the digit that follows d
+ * at position i (wrapping to 0), so advancing a position is a table lookup
+ * instead of a search through the charset.
+ */
+typedef struct
+{
+    int length;
+    uint64_t position;
+    uint64_t end;
+    const char *sets[MAX_PASSWORD_LENGTH];
+    int set_sizes[MAX_PASSWORD_LENGTH];
+    unsigned char digits[MAX_PASSWORD_LENGTH];
+    char guess[SLOT_SIZE];
+    unsigned char successor[MAX_PASSWORD_LENGTH][256];
+} CandidateGen;
+
+/*
+ * Positions gen at keyspace index begin of the guesses whose i-th character
+ * comes from sets[i]; candidates stop before end.
+ */
+void candidate_gen_init(CandidateGen *gen, const char *const *sets, int length, uint64_t begin, uint64_t end)
+{
+    memset(gen->guess, 0, sizeof(gen->guess));
+    gen->length = length;
+    gen->position = begin;
+    gen->end = end;
+    for (int i = length - 1; i >= 0; i--)
     {
-        guess[i] = charset[0];
+        int size = strlen(sets[i]);
+        for (int d = 0; d < 256; d++)
+            gen->successor[i][d] = (d + 1 < size) ? d + 1 : 0;
+
+        gen->sets[i] = sets[i];
+        gen->set_sizes[i] = size;
+        gen->digits[i] = begin % size;
+        gen->guess[i] = sets[i][gen->digits[i]];
+        begin /= size;
     }
-    guess[password_length] = '\0';
+}
 
-    long attempts = 0;
-    while (1)
+/*
+ * Writes up to max candidates into buffer, one zero-padded SLOT_SIZE slot
+ * each, and returns how many were written. Every candidate is copied with
+ * one fixed-size store and then only its last character is patched.
+ */
+size_t candidate_gen_next_batch(CandidateGen *gen, char *buffer, size_t max)
+{
+    int last = gen->length - 1;
+    size_t count = 0;
+
+    while (count < max && gen->position < gen->end)
     {
-        if (strcmp(guess, password) == 0)
+        /* Run the last position up to its wrap point in one go. */
+        uint64_t run = gen->set_sizes[last] - gen->digits[last];
+        if (run > max - count)
+            run = max - count;
+        if (run > gen->end - gen->position)
+            run = gen->end - gen->position;
+
+        const char *next = gen->sets[last] + gen->digits[last];
+        for (uint64_t k = 0; k < run; k++)
         {
-            printf("Password is found:  %s\n", guess);
-            printf("Total Attempts: %d\n", attempts);
-            free(guess);
+            memcpy(buffer, gen->guess, SLOT_SIZE);
+            buffer[last] = next[k];
+            buffer += SLOT_SIZE;
         }
+        count += run;
+        gen->position += run;
 
-        int i = password_length - 1;
+        int i = last;
+        unsigned char d = gen->digits[i] + run - 1;
         while (i >= 0)
         {
-            int pos = strchr(charset, guess[i]) - charset;
-            if (pos + 1 < charset_size)
+            d = gen->successor[i][d];
+            gen->digits[i] = d;
+            gen->guess[i] = gen->sets[i][d];
+            if (d != 0 || --i < 0)
+                break;
+            d = gen->digits[i];
+        }
+    }
+    return count;
+}
+
+/*
+ * Batch matchers. Each returns the index of the first slot in the batch
+ * equal to target (a zero-padded SLOT_SIZE slot), or -1. Because slots are
+ * zero-padded a candidate of a different length never matches.
+ */
+typedef long (*MatchFn)(const char *batch, size_t count, const char *target);
+
+static long match_batch_scalar(const char *batch, size_t count, const char *target)
+{
+    uint64_t t0, t1;
+    memcpy(&t0, target, 8);
+    memcpy(&t1, target + 8, 8);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        uint64_t c0, c1;
+        memcpy(&c0, batch + i * SLOT_SIZE, 8);
+        memcpy(&c1, batch + i * SLOT_SIZE + 8, 8);
+        if (((c0 ^ t0) | (c1 ^ t1)) == 0)
+            return (long)i;
+    }
+    return -1;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_X86_MATCHERS 1
+#include <immintrin.h>
+
+/*
+ * Compares 16 slots per step. A slot matches when all four of its dwords
+ * compare equal; the per-slot results are OR-ed together so the whole step
+ * costs one movemask, and the exact slot is only located after a hit.
+ */
+__attribute__((target("sse2"))) static long match_batch_sse2(const char *batch, size_t count, const char *target)
+{
+    __m128i t = _mm_loadu_si128((const __m128i *)target);
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i any = _mm_setzero_si128();
+        for (int k = 0; k < 16; k++)
+        {
+            __m128i c = _mm_loadu_si128((const __m128i *)(batch + (i + k) * SLOT_SIZE));
+            __m128i eq = _mm_cmpeq_epi32(c, t);
+            eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+            eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(1, 0, 3, 2)));
+            any = _mm_or_si128(any, eq);
+        }
+        if (_mm_movemask_epi8(any))
+            return (long)i + match_batch_scalar(batch + i * SLOT_SIZE, 16, target);
+    }
+
+    long tail = match_batch_scalar(batch + i * SLOT_SIZE, count - i, target);
+    return tail < 0 ? -1 : (long)i + tail;
+}
+
+/* Compares 32 slots per step, two slots per 256-bit register. */
+__attribute__((target("avx2"))) static long match_batch_avx2(const char *batch, size_t count, const char *target)
+{
+    __m256i t = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)target));
+    size_t i = 0;
+
+    for (; i + 32 <= count; i += 32)
+    {
+        __m256i any = _mm256_setzero_si256();
+        for (int k = 0; k < 32; k += 2)
+        {
+            __m256i c = _mm256_loadu_si256((const __m256i *)(batch + (i + k) * SLOT_SIZE));
+            __m256i eq = _mm256_cmpeq_epi64(c, t);
+            eq = _mm256_and_si256(eq, _mm256_shuffle_epi32(eq, _MM_SHUFFLE(1, 0, 3, 2)));
+            any = _mm256_or_si256(any, eq);
+        }
+        if (_mm256_movemask_epi8(any))
+            return (long)i + match_batch_scalar(batch + i * SLOT_SIZE, 32, target);
+    }
+
+    long tail = match_batch_sse2(batch + i * SLOT_SIZE, count - i, target);
+    return tail < 0 ? -1 : (long)i + tail;
+}
+#endif
+
+static const char *matcher_name = "scalar";
+
+/* Picks the widest matcher the CPU supports; name forces one ("scalar", "sse2", "avx2"). */
+static MatchFn select_matcher(const char *name)
+{
+#ifdef HAVE_X86_MATCHERS
+    __builtin_cpu_init();
+    int avx2 = __builtin_cpu_supports("avx2");
+    int sse2 = __builtin_cpu_supports("sse2");
+
+    if (name != NULL && strcmp(name, "scalar") == 0)
+        avx2 = sse2 = 0;
+    else if (name != NULL && strcmp(name, "sse2") == 0)
+        avx2 = 0;
+
+    if (avx2)
+    {
+        matcher_name = "avx2";
+        return match_batch_avx2;
+    }
+    if (sse2)
+    {
+        matcher_name = "sse2";
+        return match_batch_sse2;
+    }
+#else
+    (void)name;
+#endif
+    matcher_name = "scalar";
+    return match_batch_scalar;
+}
+
+static MatchFn match_batch = match_batch_scalar;
+
+#ifndef BENCHMARK_BUILD
+/*
+ * Microbenchmark: runs each available matcher over the same batch (which
+ * never contains the target) and prints candidates/s.
+ */
+static volatile long bench_sink;
+
+static void bench_matchers(void)
+{
+    const char *names[] = {"scalar", "sse2", "avx2"};
+    static char batch[BATCH_SIZE * SLOT_SIZE];
+    char target[SLOT_SIZE] = "zzzzzz";
+    CandidateGen gen;
+
+    const char *sets[6] = {charset, charset, charset, charset, charset, charset};
+
+    candidate_gen_init(&gen, sets, 6, 0, BATCH_SIZE);
+    candidate_gen_next_batch(&gen, batch, BATCH_SIZE);
+
+    for (int n = 0; n < 3; n++)
+    {
+        MatchFn fn = select_matcher(names[n]);
+        if (strcmp(matcher_name, names[n]) != 0)
+        {
+            printf("%-6s not supported on this CPU\n", names[n]);
+            continue;
+        }
+
+        uint64_t candidates = 0;
+        double start = now_seconds(), elapsed;
+        PERF_REGION_BEGIN(matcher);
+        do
+        {
+            for (int r = 0; r < 1000; r++)
+            {
+                bench_sink = fn(batch, BATCH_SIZE, target);
+            }
+            candidates += 1000ULL * BATCH_SIZE;
+            elapsed = now_seconds() - start;
+        } while (elapsed < 0.5);
+        PERF_REGION_END(matcher);
+
+        printf("%-6s %.0f candidates/s\n", names[n], candidates / elapsed);
+    }
+}
+#endif
+
+/*
+ * Hash mode. Candidates are hashed HASH_LANES at a time with the lanes in
+ * the innermost loop, so each step of the hash runs over a small array the
+ * compiler can keep in vector registers (multi-buffer hashing). Each lane
+ * has its own length (wordlist batches mix lengths). Guesses are at most
+ * MAX_PASSWORD_LENGTH bytes, so SHA-256 always needs one block.
+ */
+#define HASH_LANES 8
+
+static void fnv1a64_lanes(const char *slots, const unsigned char *lengths, uint32_t digests[][8])
+{
+    uint64_t h[HASH_LANES];
+    int longest = 0;
+
+    for (int l = 0; l < HASH_LANES; l++)
+    {
+        h[l] = 0xcbf29ce484222325ULL;
+        if (lengths[l] > longest)
+            longest = lengths[l];
+    }
+    for (int i = 0; i < longest; i++)
+    {
+        for (int l = 0; l < HASH_LANES; l++)
+        {
+            uint64_t next = (h[l] ^ (unsigned char)slots[l * SLOT_SIZE + i]) * 0x100000001b3ULL;
+            h[l] = i < lengths[l] ? next : h[l];
+        }
+    }
+    for (int l = 0; l < HASH_LANES; l++)
+    {
+        digests[l][0] = (uint32_t)(h[l] >> 32);
+        digests[l][1] = (uint32_t)h[l];
+    }
+}
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+#define ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void sha256_lanes(const char *slots, const unsigned char *lengths, uint32_t digests[][8])
+{
+    uint32_t w[64][HASH_LANES];
+    uint32_t v[8][HASH_LANES];
+    static const uint32_t init[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                     0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+    /* Single padded block: message, 0x80, zeros, 64-bit big-endian bit length. */
+    for (int l = 0; l < HASH_LANES; l++)
+    {
+        unsigned char block[64] = {0};
+        memcpy(block, slots + l * SLOT_SIZE, lengths[l]);
+        block[lengths[l]] = 0x80;
+        block[63] = (unsigned char)(lengths[l] * 8);
+        for (int t = 0; t < 16; t++)
+            w[t][l] = (uint32_t)block[4 * t] << 24 | (uint32_t)block[4 * t + 1] << 16 |
+                      (uint32_t)block[4 * t + 2] << 8 | block[4 * t + 3];
+    }
+
+    for (int t = 16; t < 64; t++)
+    {
+        for (int l = 0; l < HASH_LANES; l++)
+        {
+            uint32_t s0 = ROTR32(w[t - 15][l], 7) ^ ROTR32(w[t - 15][l], 18) ^ (w[t - 15][l] >> 3);
+            uint32_t s1 = ROTR32(w[t - 2][l], 17) ^ ROTR32(w[t - 2][l], 19) ^ (w[t - 2][l] >> 10);
+            w[t][l] = w[t - 16][l] + s0 + w[t - 7][l] + s1;
+        }
+    }
+
+    for (int i = 0; i < 8; i++)
+        for (int l = 0; l < HASH_LANES; l++)
+            v[i][l] = init[i];
+
+    for (int t = 0; t < 64; t++)
+    {
+        for (int l = 0; l < HASH_LANES; l++)
+        {
+            uint32_t a = v[0][l], b = v[1][l], c = v[2][l], d = v[3][l];
+            uint32_t e = v[4][l], f = v[5][l], g = v[6][l], h = v[7][l];
+            uint32_t t1 = h + (ROTR32(e, 6) ^ ROTR32(e, 11) ^ ROTR32(e, 25)) +
+                          ((e & f) ^ (~e & g)) + sha256_k[t] + w[t][l];
+            uint32_t t2 = (ROTR32(a, 2) ^ ROTR32(a, 13) ^ ROTR32(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            v[7][l] = g;
+            v[6][l] = f;
+            v[5][l] = e;
+            v[4][l] = d + t1;
+            v[3][l] = c;
+            v[2][l] = b;
+            v[1][l] = a;
+            v[0][l] = t1 + t2;
+        }
+    }
+
+    for (int l = 0; l < HASH_LANES; l++)
+        for (int i = 0; i < 8; i++)
+            digests[l][i] = v[i][l] + init[i];
+}
+
+/*
+ * Returns the index of the first slot whose digest equals the target, or
+ * -1. lengths holds the length of the guess in each slot.
+ */
+static long match_batch_hashed(const SearchState *state, const char *batch, const unsigned char *lengths, size_t count)
+{
+    _Alignas(32) char slots[HASH_LANES * SLOT_SIZE];
+    unsigned char slot_lengths[HASH_LANES];
+    uint32_t digests[HASH_LANES][8];
+    int words = state->hash == HASH_SHA256 ? 8 : 2;
+
+    for (size_t i = 0; i < count; i += HASH_LANES)
+    {
+        size_t lanes = count - i < HASH_LANES ? count - i : HASH_LANES;
+        const char *input = batch + i * SLOT_SIZE;
+        const unsigned char *input_lengths = lengths + i;
+        if (lanes < HASH_LANES)
+        {
+            memset(slots, 0, sizeof(slots));
+            memset(slot_lengths, 0, sizeof(slot_lengths));
+            memcpy(slots, input, lanes * SLOT_SIZE);
+            memcpy(slot_lengths, input_lengths, lanes);
+            input = slots;
+            input_lengths = slot_lengths;
+        }
+
+        if (state->hash == HASH_SHA256)
+            sha256_lanes(input, input_lengths, digests);
+        else
+            fnv1a64_lanes(input, input_lengths, digests);
+
+        for (size_t l = 0; l < lanes; l++)
+        {
+            if (memcmp(digests[l], state->target_digest, words * sizeof(uint32_t)) == 0)
+                return (long)(i + l);
+        }
+    }
+    return -1;
+}
+
+/* Parses a hex digest into 32-bit words; returns 0 unless it has exactly words*8 digits. */
+static int parse_digest(const char *hex, uint32_t *digest, int words)
+{
+    if ((int)strlen(hex) != words * 8)
+        return 0;
+    for (int i = 0; i < words; i++)
+    {
+        digest[i] = 0;
+        for (int j = 0; j < 8; j++)
+        {
+            int c = tolower((unsigned char)hex[i * 8 + j]);
+            if (!isxdigit(c))
+                return 0;
+            digest[i] = digest[i] << 4 | (uint32_t)(isdigit(c) ? c - '0' : c - 'a' + 10);
+        }
+    }
+    return 1;
+}
+
+#ifndef BENCHMARK_BUILD
+/* Prints the digest of word in the given hash, for producing test targets. */
+static void print_digest(HashKind hash, const char *word)
+{
+    _Alignas(32) char slots[HASH_LANES * SLOT_SIZE] = {0};
+    unsigned char lengths[HASH_LANES] = {0};
+    uint32_t digests[HASH_LANES][8];
+    int length = strlen(word);
+
+    if (length > MAX_PASSWORD_LENGTH)
+        length = MAX_PASSWORD_LENGTH;
+    memcpy(slots, word, length);
+    lengths[0] = length;
+    if (hash == HASH_SHA256)
+        sha256_lanes(slots, lengths, digests);
+    else
+        fnv1a64_lanes(slots, lengths, digests);
+
+    for (int i = 0; i < (hash == HASH_SHA256 ? 8 : 2); i++)
+        printf("%08x", digests[0][i]);
+    printf("\n");
+}
+#endif
+
+static int load_checkpoint(const char *path, Checkpoint *checkpoint)
+{
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL)
+        return 0;
+    int ok = fread(checkpoint, sizeof(*checkpoint), 1, fp) == 1 &&
+             memcmp(checkpoint->magic, "PCK1", 4) == 0;
+    fclose(fp);
+    return ok;
+}
+
+/* Writes the checkpoint to a temporary file and renames it into place. */
+static int save_checkpoint(const char *path, uint32_t length, uint64_t offset)
+{
+    char tmp_path[1024];
+    Checkpoint checkpoint;
+
+    memcpy(checkpoint.magic, "PCK1", 4);
+    checkpoint.length = length;
+    checkpoint.offset = offset;
+
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+    FILE *fp = fopen(tmp_path, "wb");
+    if (fp == NULL)
+        return 0;
+    int ok = fwrite(&checkpoint, sizeof(checkpoint), 1, fp) == 1;
+    ok = (fclose(fp) == 0) && ok;
+    return ok && rename(tmp_path, path) == 0;
+}
+
+/*
+ * Records how far the current pass has safely progressed: the lowest start
+ * of any chunk a worker may still be working on.
+ */
+static void write_progress_checkpoint(SearchState *state)
+{
+    uint64_t offset = atomic_load(&state->next_index);
+    for (int i = 0; i < state->threads; i++)
+    {
+        uint64_t floor = atomic_load(&state->workers[i].chunk_floor);
+        if (floor < offset)
+            offset = floor;
+    }
+    if (offset > state->keyspace)
+        offset = state->keyspace;
+
+    pthread_mutex_lock(&state->checkpoint_lock);
+    if (!save_checkpoint(state->options->checkpoint_path, state->length, offset))
+        fprintf(stderr, "warning: could not write checkpoint %s\n", state->options->checkpoint_path);
+    pthread_mutex_unlock(&state->checkpoint_lock);
+}
+
+/* Records a match; only the first worker to find one gets to report it. */
+static void report_found(SearchState *state, uint64_t index, const char *guess, int length)
+{
+    int expected = 0;
+    if (atomic_compare_exchange_strong(&state->found, &expected, 1))
+    {
+        state->found_index = index;
+        memcpy(state->result, guess, length);
+        state->result[length] = '\0';
+    }
+}
+
+/* Tries keyspace indices [begin, end) of the current pass; returns the attempts made. */
+static uint64_t scan_keyspace_chunk(SearchState *state, uint64_t begin, uint64_t end)
+{
+    _Alignas(32) char batch[BATCH_SIZE * SLOT_SIZE];
+    unsigned char lengths[BATCH_SIZE];
+    CandidateGen gen;
+    uint64_t attempts = 0;
+    size_t count;
+
+    memset(lengths, state->length, sizeof(lengths));
+    candidate_gen_init(&gen, state->sets, state->length, begin, end);
+    while ((count = candidate_gen_next_batch(&gen, batch, BATCH_SIZE)) > 0)
+    {
+        long hit = state->hash == HASH_NONE ? match_batch(batch, count, state->target)
+                                            : match_batch_hashed(state, batch, lengths, count);
+        if (hit >= 0)
+        {
+            report_found(state, gen.position - count + hit, batch + hit * SLOT_SIZE, state->length);
+            return attempts + hit + 1;
+        }
+        attempts += count;
+    }
+    return attempts;
+}
+
+/*
+ * Tries the words of wordlist bytes [begin, end). A line belongs to the
+ * chunk its first byte is in, so chunks split the file on line boundaries
+ * without any coordination. Words are copied straight from the mapping
+ * into batch slots; nothing is allocated per word.
+ */
+static uint64_t scan_wordlist_chunk(SearchState *state, uint64_t begin, uint64_t end)
+{
+    _Alignas(32) char batch[BATCH_SIZE * SLOT_SIZE];
+    unsigned char lengths[BATCH_SIZE];
+    uint64_t offsets[BATCH_SIZE];
+    const char *words = state->words;
+    uint64_t size = state->keyspace;
+    uint64_t attempts = 0;
+    uint64_t pos = begin;
+    size_t count = 0;
+
+    if (pos > 0)
+    {
+        const char *newline = memchr(words + pos - 1, '\n', size - (pos - 1));
+        pos = newline != NULL ? (uint64_t)(newline - words) + 1 : size;
+    }
+
+    while (pos < end || count > 0)
+    {
+        if (pos < end)
+        {
+            const char *line = words + pos;
+            const char *newline = memchr(line, '\n', size - pos);
+            size_t length = newline != NULL ? (size_t)(newline - line) : size - pos;
+            uint64_t line_start = pos;
+
+            pos += length + 1;
+            if (length > 0 && line[length - 1] == '\r')
+                length--;
+            if (length == 0 || length > MAX_PASSWORD_LENGTH)
+                continue;
+
+            char *slot = batch + count * SLOT_SIZE;
+            memset(slot, 0, SLOT_SIZE);
+            memcpy(slot, line, length);
+            lengths[count] = length;
+            offsets[count] = line_start;
+            if (++count < BATCH_SIZE && pos < end)
+                continue;
+        }
+
+        long hit = state->hash == HASH_NONE ? match_batch(batch, count, state->target)
+                                            : match_batch_hashed(state, batch, lengths, count);
+        if (hit >= 0)
+        {
+            report_found(state, offsets[hit], batch + hit * SLOT_SIZE, lengths[hit]);
+            return attempts + hit + 1;
+        }
+        attempts += count;
+        count = 0;
+    }
+    return attempts;
+}
+
+static void *worker_main(void *arg)
+{
+    Worker *worker = (Worker *)arg;
+    SearchState *state = worker->state;
+    double start = now_seconds();
+
+    while (!atomic_load_explicit(&state->found, memory_order_relaxed))
+    {
+        /* Publish a lower bound before claiming so checkpoints never skip a chunk. */
+        atomic_store(&worker->chunk_floor, atomic_load(&state->next_index));
+        uint64_t begin = atomic_fetch_add(&state->next_index, state->chunk_size);
+        if (begin >= state->keyspace)
+            break;
+        uint64_t end = begin + state->chunk_size;
+        if (end > state->keyspace)
+            end = state->keyspace;
+
+        uint64_t chunk_attempts;
+        if (state->words != NULL)
+        {
+            chunk_attempts = scan_wordlist_chunk(state, begin, end);
+            /* Drop the pages behind us so resident memory stays constant. */
+            uint64_t page = (uint64_t)sysconf(_SC_PAGESIZE);
+            uint64_t first = (begin + page - 1) / page * page;
+            uint64_t last = end / page * page;
+            if (last > first)
+                madvise((char *)state->words + first, last - first, MADV_DONTNEED);
+        }
+        else
+        {
+            chunk_attempts = scan_keyspace_chunk(state, begin, end);
+        }
+        worker->attempts += chunk_attempts;
+        if (state->progress != NULL)
+            progressAdd(state->progress, end - begin);
+
+        uint64_t total = atomic_fetch_add(&state->total_attempts, chunk_attempts) + chunk_attempts;
+        uint64_t due = atomic_load(&state->next_checkpoint);
+        if (state->options->checkpoint_path != NULL && total >= due &&
+            atomic_compare_exchange_strong(&state->next_checkpoint, &due,
+                                           total + state->options->checkpoint_interval))
+        {
+            /* This chunk is done; only count it as pending if it was the lowest. */
+            atomic_store(&worker->chunk_floor, end);
+            write_progress_checkpoint(state);
+        }
+    }
+
+    worker->seconds += now_seconds() - start;
+    return NULL;
+}
+
+/* Runs the workers over [offset, state->keyspace) of the current pass. */
+static void search_pass(SearchState *state, uint64_t offset)
+{
+    atomic_store(&state->next_index, offset);
+
+    for (int i = 0; i < state->threads; i++)
+    {
+        atomic_store(&state->workers[i].chunk_floor, offset);
+        pthread_create(&state->workers[i].thread, NULL, worker_main, &state->workers[i]);
+    }
+    for (int i = 0; i < state->threads; i++)
+        pthread_join(state->workers[i].thread, NULL);
+}
+
+/* Guesses of the given length with sets[i] tried at position i; 0 if that overflows. */
+static uint64_t keyspace_size(int length, const char *const *sets)
+{
+    uint64_t size = 1;
+    for (int i = 0; i < length; i++)
+    {
+        uint64_t choices = strlen(sets[i]);
+        if (size > UINT64_MAX / choices)
+            return 0;
+        size *= choices;
+    }
+    return size;
+}
+
+/*
+ * Sets the current pass to guesses of the given length with sets[i] tried
+ * at position i; returns 0 if the keyspace does not fit in 64 bits.
+ */
+static int set_pass(SearchState *state, int length, const char *const *sets)
+{
+    state->length = length;
+    state->keyspace = 1;
+    for (int i = 0; i < length; i++)
+    {
+        uint64_t size = strlen(sets[i]);
+        if (state->keyspace > UINT64_MAX / size)
+            return 0;
+        state->keyspace *= size;
+        state->sets[i] = sets[i];
+    }
+    return 1;
+}
+
+/*
+ * Mask character classes, as in ?l?l?d?d: ?l lowercase, ?u uppercase,
+ * ?d digits, ?s symbols, ?a all of them, ?? a literal '?'. Any other
+ * character matches itself. Fills sets and returns the mask length, or -1
+ * if the mask is invalid or longer than MAX_PASSWORD_LENGTH.
+ */
+static int parse_mask(const char *mask, const char **sets, char literals[][2])
+{
+    static const char *lower = "abcdefghijklmnopqrstuvwxyz";
+    static const char *upper = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    static const char *digits = "0123456789";
+    static const char *symbols = " !\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~";
+    static const char *all = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+                             " !\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~";
+    int length = 0;
+
+    for (const char *m = mask; *m != '\0'; m++)
+    {
+        if (length == MAX_PASSWORD_LENGTH)
+            return -1;
+        if (*m == '?')
+        {
+            switch (*++m)
             {
-                guess[i] = charset[pos + 1];
+            case 'l':
+                sets[length] = lower;
                 break;
+            case 'u':
+                sets[length] = upper;
+                break;
+            case 'd':
+                sets[length] = digits;
+                break;
+            case 's':
+                sets[length] = symbols;
+                break;
+            case 'a':
+                sets[length] = all;
+                break;
+            case '?':
+                literals[length][0] = '?';
+                literals[length][1] = '\0';
+                sets[length] = literals[length];
+                break;
+            default:
+                return -1;
             }
-            else
+        }
+        else
+        {
+            literals[length][0] = *m;
+            literals[length][1] = '\0';
+            sets[length] = literals[length];
+        }
+        length++;
+    }
+    return length;
+}
+
+/* Maps the wordlist read-only; returns NULL on failure. */
+static const char *map_wordlist(const char *path, uint64_t *size)
+{
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+
+    if (fd < 0)
+        return NULL;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return NULL;
+
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+    *size = st.st_size;
+    return (const char *)data;
+}
+
+/*
+ * Searches for password. In hash mode (options->hash != HASH_NONE) the
+ * password argument is the hex digest of the unknown password instead.
+ */
+int bruteforce(const char *password, const SearchOptions *options)
+{
+    SearchState state;
+    int threads = options->threads;
+    int password_length = options->hash == HASH_NONE ? (int)strlen(password) : 0;
+    int first_length = options->min_length;
+    uint64_t first_offset = 0;
+    const char *mask_sets[MAX_PASSWORD_LENGTH];
+    char mask_literals[MAX_PASSWORD_LENGTH][2];
+    const char *full_sets[MAX_PASSWORD_LENGTH];
+    uint64_t wordlist_size = 0;
+
+    if (password_length > MAX_PASSWORD_LENGTH || options->max_length > MAX_PASSWORD_LENGTH)
+    {
+        printf("password is too long (max %d characters)\n", MAX_PASSWORD_LENGTH);
+        return 1;
+    }
+
+    state.hash = options->hash;
+    memset(state.target_digest, 0, sizeof(state.target_digest));
+    if (options->hash != HASH_NONE &&
+        !parse_digest(password, state.target_digest, options->hash == HASH_SHA256 ? 8 : 2))
+    {
+        printf("digest must be %d hex digits\n", options->hash == HASH_SHA256 ? 64 : 16);
+        return 1;
+    }
+
+    for (int i = 0; i < MAX_PASSWORD_LENGTH; i++)
+        full_sets[i] = charset;
+
+    state.words = NULL;
+    state.chunk_size = CHUNK_SIZE;
+    if (options->wordlist_path != NULL)
+    {
+        state.words = map_wordlist(options->wordlist_path, &wordlist_size);
+        if (state.words == NULL)
+        {
+            printf("cannot read wordlist %s\n", options->wordlist_path);
+            return 1;
+        }
+        state.chunk_size = WORDLIST_CHUNK_SIZE;
+        first_length = 0;
+    }
+    else if (options->mask != NULL)
+    {
+        first_length = parse_mask(options->mask, mask_sets, mask_literals);
+        if (first_length <= 0)
+        {
+            printf("invalid mask %s\n", options->mask);
+            return 1;
+        }
+    }
+
+    if (options->checkpoint_path != NULL)
+    {
+        Checkpoint checkpoint;
+        int last_length = options->wordlist_path != NULL || options->mask != NULL ? first_length : options->max_length;
+        if (load_checkpoint(options->checkpoint_path, &checkpoint) &&
+            (int)checkpoint.length >= first_length &&
+            (int)checkpoint.length <= last_length)
+        {
+            first_length = checkpoint.length;
+            first_offset = checkpoint.offset;
+            printf("resuming from checkpoint: length %d, offset %llu\n",
+                   first_length, (unsigned long long)first_offset);
+        }
+    }
+
+    state.password = password;
+    state.password_length = password_length;
+    memset(state.target, 0, sizeof(state.target));
+    memcpy(state.target, password, password_length);
+    atomic_init(&state.next_index, 0);
+    atomic_init(&state.found, 0);
+    state.found_index = 0;
+    state.result[0] = '\0';
+    state.threads = threads;
+    state.options = options;
+    atomic_init(&state.total_attempts, 0);
+    atomic_init(&state.next_checkpoint, options->checkpoint_interval);
+    pthread_mutex_init(&state.checkpoint_lock, NULL);
+
+    state.workers = (Worker *)calloc(threads, sizeof(Worker));
+    if (state.workers == NULL)
+    {
+        printf("memory allocation failed\n");
+        return 1;
+    }
+    for (int i = 0; i < threads; i++)
+    {
+        state.workers[i].state = &state;
+        state.workers[i].id = i;
+    }
+
+    ProgressReporter progress;
+    state.progress = NULL;
+    if (options->progress)
+    {
+        /* Total work in keyspace indices (wordlist bytes); 0 when it overflows */
+        uint64_t total = 0;
+        if (state.words != NULL)
+            total = wordlist_size;
+        else if (options->mask != NULL)
+            total = keyspace_size(first_length, mask_sets);
+        else
+            for (int length = first_length; length <= options->max_length; length++)
             {
-                guess[i] = charset[0];
+                uint64_t size = keyspace_size(length, full_sets);
+                total = size == 0 || total > UINT64_MAX - size ? 0 : total + size;
+                if (total == 0)
+                    break;
             }
+        if (total > first_offset)
+            total -= first_offset;
+
+        progressInit(&progress, "pass", state.words != NULL ? "bytes" : "guesses", total, 0);
+        if (progressStart(&progress) == SUCCESS)
+            state.progress = &progress;
+    }
+
+    double start = now_seconds();
+    PERF_REGION_BEGIN(search);
+    if (state.words != NULL)
+    {
+        state.length = 0;
+        state.keyspace = wordlist_size;
+        search_pass(&state, first_offset);
+    }
+    else if (options->mask != NULL)
+    {
+        if (!set_pass(&state, first_length, mask_sets))
+            printf("mask keyspace does not fit in 64 bits\n");
+        else
+            search_pass(&state, first_offset);
+    }
+    else
+    {
+        for (int length = first_length; length <= options->max_length; length++)
+        {
+            set_pass(&state, length, full_sets);
+            search_pass(&state, length == first_length ? first_offset : 0);
+            if (atomic_load(&state.found))
+                break;
+            if (options->checkpoint_path != NULL && length < options->max_length)
+                save_checkpoint(options->checkpoint_path, length + 1, 0);
+        }
+    }
+    PERF_REGION_END(search);
+    double elapsed = now_seconds() - start;
+    if (state.progress != NULL)
+        progressStop(state.progress);
+
+    uint64_t attempts = 0;
+    for (int i = 0; i < threads; i++)
+        attempts += state.workers[i].attempts;
+
+    if (!options->quiet)
+    {
+        for (int i = 0; i < threads; i++)
+        {
+            Worker *worker = &state.workers[i];
+            double rate = worker->seconds > 0 ? worker->attempts / worker->seconds : 0;
+            printf("worker %d: %llu attempts, %.0f attempts/s\n",
+                   worker->id, (unsigned long long)worker->attempts, rate);
         }
-        attempts++;
-        if (attempts % 1000 == 0)
+
+        if (atomic_load(&state.found))
         {
-            printf("attempts: %d\n ", attempts,guess[i]);
+            printf("Password is found:  %s\n", state.result);
+            if (state.words != NULL)
+                printf("Wordlist offset: byte %llu\n", (unsigned long long)state.found_index);
+            else
+                printf("Keyspace position: %llu (length %d)\n",
+                       (unsigned long long)state.found_index, state.length);
         }
+        else
+        {
+            printf("Password not found\n");
+        }
+        printf("Total Attempts: %llu\n", (unsigned long long)attempts);
+        if (options->hash == HASH_NONE)
+            printf("Elapsed: %.3f s (%.0f attempts/s on %d threads, %s matcher)\n",
+                   elapsed, elapsed > 0 ? attempts / elapsed : 0, threads, matcher_name);
+        else
+            printf("Elapsed: %.3f s (%.0f hashes/s on %d threads, %s)\n",
+                   elapsed, elapsed > 0 ? attempts / elapsed : 0, threads,
+                   options->hash == HASH_SHA256 ? "sha256" : "fnv1a64");
     }
+
+    /* The search has finished, so there is nothing left to resume. */
+    if (options->checkpoint_path != NULL)
+        remove(options->checkpoint_path);
+
+    if (state.words != NULL)
+        munmap((void *)state.words, wordlist_size);
+    pthread_mutex_destroy(&state.checkpoint_lock);
+    free(state.workers);
+    return atomic_load(&state.found) ? 0 : 1;
+}
+
+#ifdef BENCHMARK_BUILD
+/*
+ * Entry point for benchmark_suite.c: an exhaustive search for password at
+ * its own length, without the report.
+ */
+int pass_benchmark(const char *password, int threads)
+{
+    SearchOptions options;
+
+    match_batch = select_matcher(NULL);
+    options.threads = threads < 1 ? 1 : threads > MAX_THREADS ? MAX_THREADS : threads;
+    options.hash = HASH_NONE;
+    options.min_length = (int)strlen(password);
+    options.max_length = (int)strlen(password);
+    options.mask = NULL;
+    options.wordlist_path = NULL;
+    options.checkpoint_path = NULL;
+    options.checkpoint_interval = 100 * 1000000ULL;
+    options.quiet = 1;
+    options.progress = 0;
+    return bruteforce(password, &options);
 }
-int main(){
-    char password[50];
-    printf("enter password to brute force:");
-    scanf("%s", password);
+#else
+int main(int argc, char *argv[])
+{
+    char password[80] = "";
+    SearchOptions options;
+    int max_length = 0;
+    const char *matcher = NULL;
+    const char *digest_of = NULL;
+
+    options.threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    options.hash = HASH_NONE;
+    options.mask = NULL;
+    options.wordlist_path = NULL;
+    options.checkpoint_path = NULL;
+    options.checkpoint_interval = 100 * 1000000ULL;
+    options.quiet = 0;
+    options.progress = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            options.threads = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--matcher") == 0 && i + 1 < argc)
+        {
+            matcher = argv[++i];
+        }
+        else if (strcmp(argv[i], "--bench-match") == 0)
+        {
+            bench_matchers();
+            return 0;
+        }
+        else if (strcmp(argv[i], "--hash") == 0 && i + 1 < argc)
+        {
+            i++;
+            if (strcmp(argv[i], "sha256") == 0)
+                options.hash = HASH_SHA256;
+            else if (strcmp(argv[i], "fnv1a") == 0)
+                options.hash = HASH_FNV1A64;
+            else
+            {
+                printf("unknown hash %s (use fnv1a or sha256)\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--digest-of") == 0 && i + 1 < argc)
+        {
+            digest_of = argv[++i];
+        }
+        else if (strcmp(argv[i], "--mask") == 0 && i + 1 < argc)
+        {
+            options.mask = argv[++i];
+        }
+        else if (strcmp(argv[i], "--wordlist") == 0 && i + 1 < argc)
+        {
+            options.wordlist_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--max-length") == 0 && i + 1 < argc)
+        {
+            max_length = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc)
+        {
+            options.checkpoint_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--progress") == 0)
+        {
+            options.progress = 1;
+        }
+        else if (strcmp(argv[i], "--checkpoint-every") == 0 && i + 1 < argc)
+        {
+            /* given in millions of attempts */
+            options.checkpoint_interval = strtoull(argv[++i], NULL, 10) * 1000000ULL;
+        }
+        else
+        {
+            strncpy(password, argv[i], sizeof(password) - 1);
+            password[sizeof(password) - 1] = '\0';
+        }
+    }
+
+    if (digest_of != NULL)
+    {
+        print_digest(options.hash == HASH_NONE ? HASH_SHA256 : options.hash, digest_of);
+        return 0;
+    }
+
+    match_batch = select_matcher(matcher);
+
+    if (options.threads < 1)
+        options.threads = 1;
+    if (options.threads > MAX_THREADS)
+        options.threads = MAX_THREADS;
+    if (options.checkpoint_interval == 0)
+        options.checkpoint_interval = 1000000ULL;
+
+    if (password[0] == '\0')
+    {
+        printf(options.hash == HASH_NONE ? "enter password to brute force:" : "enter digest to crack:");
+        scanf("%79s", password);
+    }
 
     if(strlen(password)==0){
         printf("password is empty");
         return 1;
     }
-    int password_length = strlen(password);
-    bruteforce(password, password_length);
-    return 0;
 
-}
\ No newline at end of file
+    /* Without --max-length only guesses as long as the password are tried. */
+    if (options.hash != HASH_NONE && max_length <= 0 &&
+        options.mask == NULL && options.wordlist_path == NULL)
+    {
+        printf("--max-length, --mask or --wordlist is required in hash mode\n");
+        return 1;
+    }
+    if (max_length > 0)
+    {
+        options.min_length = 1;
+        options.max_length = max_length;
+    }
+    else if (options.hash != HASH_NONE)
+    {
+        /* mask or wordlist mode: the lengths come from the mask or the words */
+        options.min_length = 1;
+        options.max_length = 1;
+    }
+    else
+    {
+        options.min_length = strlen(password);
+        options.max_length = strlen(password);
+    }
+    return bruteforce(password, &options);
+
+}
+#endif /* BENCHMARK_BUILD */
\ No newline at end of file
@@ -0,0 +1,461 @@
+/**
+ * @file pattern_utils.c
+ * @brief Rasterizing the star patterns into a text canvas
+ * @version 1.0
+ * @date 2024
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "pattern_utils.h"
+
+/**
+ * @brief Cells in a fill template; longer runs copy it several times
+ */
+#define PATTERN_TEMPLATE_CELLS 4096
+
+/*
+ * Prefaulting the whole mapping at once is several times cheaper than
+ * taking a page fault for every 4 KiB of a large pattern.
+ */
+#ifdef MAP_POPULATE
+#define PATTERN_MAP_FLAGS (MAP_SHARED | MAP_POPULATE)
+#else
+#define PATTERN_MAP_FLAGS MAP_SHARED
+#endif
+
+/**
+ * @brief Allocates memory or exits
+ */
+static void *allocOrExit(size_t size)
+{
+    void *ptr = malloc(size > 0 ? size : 1);
+    if (ptr == NULL)
+    {
+        printf("Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    return ptr;
+}
+
+size_t patternRowOffset(PatternShape shape, int n, int row)
+{
+    size_t i = (size_t)row;
+    size_t rows = (size_t)n;
+
+    if (n <= 0 || row <= 0)
+        return 0;
+    switch (shape)
+    {
+    case PATTERN_HALF_PYRAMID:
+        /* row k is 2(k + 1) + 1 bytes */
+        return i * (i + 2);
+    case PATTERN_TRIANGLE:
+        /* row k is n + k + 2 bytes */
+        return i * (rows + 2) + i * (i - 1) / 2;
+    case PATTERN_HOLLOW_SQUARE:
+        return i * (2 * rows + 1);
+    }
+    return 0;
+}
+
+size_t patternSize(PatternShape shape, int n)
+{
+    return patternRowOffset(shape, n, n);
+}
+
+/**
+ * @brief The rows one thread fills
+ */
+typedef struct {
+    PatternShape shape;
+    int n;
+    int first;
+    int last;
+    char *canvas;          /* where row first goes */
+    const char *cells;     /* PATTERN_TEMPLATE_CELLS copies of "* " or "S " */
+    pthread_t thread;
+} PatternSlice;
+
+/**
+ * @brief Writes count two-byte cells, copying from the template
+ */
+static char *fillCells(char *out, const char *cells, size_t count)
+{
+    while (count > 0)
+    {
+        size_t chunk = count < PATTERN_TEMPLATE_CELLS ? count : PATTERN_TEMPLATE_CELLS;
+        memcpy(out, cells, 2 * chunk);
+        out += 2 * chunk;
+        count -= chunk;
+    }
+    return out;
+}
+
+/**
+ * @brief Fills one row
+ */
+static char *fillRow(char *out, PatternShape shape, int n, int row, const char *cells)
+{
+    size_t rows = (size_t)n;
+
+    switch (shape)
+    {
+    case PATTERN_HALF_PYRAMID:
+        out = fillCells(out, cells, (size_t)row + 1);
+        break;
+    case PATTERN_TRIANGLE:
+        memset(out, ' ', rows - 1 - row);
+        out = fillCells(out + rows - 1 - row, cells, (size_t)row + 1);
+        break;
+    case PATTERN_HOLLOW_SQUARE:
+        if (row == 0 || row == n - 1)
+        {
+            out = fillCells(out, cells, rows);
+        }
+        else
+        {
+            /* "S", the 2n - 3 blanks between the borders, then "S " */
+            *out++ = 'S';
+            memset(out, ' ', 2 * rows - 3);
+            out += 2 * rows - 3;
+            *out++ = 'S';
+            *out++ = ' ';
+        }
+        break;
+    }
+    *out++ = '\n';
+    return out;
+}
+
+static void *fillSlice(void *arg)
+{
+    PatternSlice *slice = (PatternSlice *)arg;
+    char *out = slice->canvas;
+
+    for (int row = slice->first; row < slice->last; row++)
+        out = fillRow(out, slice->shape, slice->n, row, slice->cells);
+    return NULL;
+}
+
+/**
+ * @brief First row whose offset is at least target, searching first..last
+ */
+static int rowAtOffset(PatternShape shape, int n, int first, int last, size_t target)
+{
+    while (first < last)
+    {
+        int mid = first + (last - first) / 2;
+        if (patternRowOffset(shape, n, mid) < target)
+            first = mid + 1;
+        else
+            last = mid;
+    }
+    return first;
+}
+
+static char g_starCells[2 * PATTERN_TEMPLATE_CELLS];
+static char g_squareCells[2 * PATTERN_TEMPLATE_CELLS];
+static pthread_once_t g_cellsOnce = PTHREAD_ONCE_INIT;
+
+static void initCells(void)
+{
+    for (int i = 0; i < PATTERN_TEMPLATE_CELLS; i++)
+    {
+        memcpy(g_starCells + 2 * i, "* ", 2);
+        memcpy(g_squareCells + 2 * i, "S ", 2);
+    }
+}
+
+void patternRasterize(PatternShape shape, int n, int first, int last, char *canvas, int threads)
+{
+    if (n <= 0 || first >= last)
+        return;
+
+    pthread_once(&g_cellsOnce, initCells);
+    const char *cells = shape == PATTERN_HOLLOW_SQUARE ? g_squareCells : g_starCells;
+    size_t base = patternRowOffset(shape, n, first);
+    size_t bytes = patternRowOffset(shape, n, last) - base;
+
+    if (bytes < PATTERN_PARALLEL_MIN)
+        threads = 1;
+    else if (threads <= 0)
+        threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads < 1)
+        threads = 1;
+    if (threads > last - first)
+        threads = last - first;
+
+    PatternSlice *slices = (PatternSlice *)allocOrExit(threads * sizeof(PatternSlice));
+
+    /* Split by bytes rather than rows: pyramid rows grow as they go */
+    int row = first;
+    for (int t = 0; t < threads; t++)
+    {
+        int end = t == threads - 1
+                      ? last
+                      : rowAtOffset(shape, n, row, last, base + bytes / threads * (t + 1));
+        slices[t].shape = shape;
+        slices[t].n = n;
+        slices[t].first = row;
+        slices[t].last = end;
+        slices[t].canvas = canvas + (patternRowOffset(shape, n, row) - base);
+        slices[t].cells = cells;
+        row = end;
+    }
+
+    for (int t = 1; t < threads; t++)
+        pthread_create(&slices[t].thread, NULL, fillSlice, &slices[t]);
+    fillSlice(&slices[0]);
+    for (int t = 1; t < threads; t++)
+        pthread_join(slices[t].thread, NULL);
+    free(slices);
+}
+
+void patternRowsInit(PatternRows *rows, PatternShape shape, int n)
+{
+    size_t count = n > 0 ? (size_t)n : 0;
+
+    rows->shape = shape;
+    rows->n = n;
+    rows->length = 0;
+    rows->text = NULL;
+    if (count == 0)
+        return;
+
+    pthread_once(&g_cellsOnce, initCells);
+    switch (shape)
+    {
+    case PATTERN_HALF_PYRAMID:
+        rows->length = 2 * count;
+        rows->text = (char *)allocOrExit(rows->length);
+        fillCells(rows->text, g_starCells, count);
+        break;
+    case PATTERN_TRIANGLE:
+        rows->length = (count - 1) + 2 * count;
+        rows->text = (char *)allocOrExit(rows->length);
+        memset(rows->text, ' ', count - 1);
+        fillCells(rows->text + count - 1, g_starCells, count);
+        break;
+    case PATTERN_HOLLOW_SQUARE:
+        /* row 0 is the border, row 1 (when there is one) the interior */
+        rows->length = (count > 2 ? 2 : 1) * (2 * count + 1);
+        rows->text = (char *)allocOrExit(rows->length);
+        fillRow(rows->text, shape, n, 0, g_squareCells);
+        if (count > 2)
+            fillRow(rows->text + 2 * count + 1, shape, n, 1, g_squareCells);
+        break;
+    }
+}
+
+void patternRowsFree(PatternRows *rows)
+{
+    free(rows->text);
+    rows->text = NULL;
+    rows->length = 0;
+}
+
+int patternRowSlices(const PatternRows *rows, int row, struct iovec slices[2])
+{
+    static char newline[] = "\n";
+    size_t i = (size_t)row;
+    size_t count = (size_t)rows->n;
+
+    switch (rows->shape)
+    {
+    case PATTERN_HALF_PYRAMID:
+        slices[0].iov_base = rows->text;
+        slices[0].iov_len = 2 * (i + 1);
+        break;
+    case PATTERN_TRIANGLE:
+        slices[0].iov_base = rows->text + i;
+        slices[0].iov_len = count + i + 1;
+        break;
+    case PATTERN_HOLLOW_SQUARE:
+        slices[0].iov_base = rows->text + (row == 0 || row == rows->n - 1 ? 0 : 2 * count + 1);
+        slices[0].iov_len = 2 * count + 1;
+        return 1;
+    }
+    slices[1].iov_base = newline;
+    slices[1].iov_len = 1;
+    return 2;
+}
+
+/**
+ * @brief Hands count slices to writev(), resuming after short writes
+ */
+static int writeSlices(int fd, struct iovec *slices, int count)
+{
+    while (count > 0)
+    {
+        ssize_t n = writev(fd, slices, count);
+        if (n <= 0)
+            return -1;
+
+        size_t written = (size_t)n;
+        while (count > 0 && written >= slices->iov_len)
+        {
+            written -= slices->iov_len;
+            slices++;
+            count--;
+        }
+        if (count > 0)
+        {
+            slices->iov_base = (char *)slices->iov_base + written;
+            slices->iov_len -= written;
+        }
+    }
+    return 0;
+}
+
+int patternWriteRows(int fd, PatternShape shape, int n)
+{
+    struct iovec slices[PATTERN_IOVECS];
+    PatternRows rows;
+    int count = 0;
+    int result = 0;
+
+    patternRowsInit(&rows, shape, n);
+    for (int row = 0; row < n && result == 0; row++)
+    {
+        count += patternRowSlices(&rows, row, slices + count);
+        if (count > PATTERN_IOVECS - 2)
+        {
+            result = writeSlices(fd, slices, count);
+            count = 0;
+        }
+    }
+    if (result == 0)
+        result = writeSlices(fd, slices, count);
+    patternRowsFree(&rows);
+    return result;
+}
+
+/**
+ * @brief Rasterizes straight into a shared mapping of a regular file
+ * @return 0 on success, 1 if the file cannot be mapped (nothing was changed), -1 on error
+ */
+static int mapPattern(int fd, PatternShape shape, int n, int threads)
+{
+    struct stat st;
+    int flags = fcntl(fd, F_GETFL);
+
+    if (flags < 0 || (flags & O_ACCMODE) != O_RDWR || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+        return 1;
+
+    off_t offset = lseek(fd, 0, SEEK_CUR);
+    if (offset < 0)
+        return 1;
+
+    size_t size = patternSize(shape, n);
+    off_t end = offset + (off_t)size;
+    if (end > st.st_size && ftruncate(fd, end) != 0)
+        return 1;
+
+    /* mmap() wants a page aligned file offset */
+    off_t page = (off_t)sysconf(_SC_PAGESIZE);
+    off_t start = offset / page * page;
+    size_t length = (size_t)(end - start);
+    char *map = (char *)mmap(NULL, length, PROT_READ | PROT_WRITE, PATTERN_MAP_FLAGS, fd, start);
+    if (map == MAP_FAILED)
+    {
+        if (end > st.st_size)
+            ftruncate(fd, st.st_size);
+        return 1;
+    }
+
+    patternRasterize(shape, n, 0, n, map + (offset - start), threads);
+    munmap(map, length);
+    return lseek(fd, end, SEEK_SET) == end ? 0 : -1;
+}
+
+/**
+ * @brief Rasterizes the pattern window by window, handing each to out
+ */
+static int writeWindows(FILE *out, PatternShape shape, int n, int threads)
+{
+    /* A window holds at least one row; the last row is the longest */
+    size_t longest = patternRowOffset(shape, n, n) - patternRowOffset(shape, n, n - 1);
+    size_t capacity = longest > PATTERN_WINDOW_BYTES ? longest : PATTERN_WINDOW_BYTES;
+    size_t total = patternSize(shape, n);
+    if (capacity > total)
+        capacity = total;
+
+    char *window = (char *)allocOrExit(capacity);
+    int result = 0;
+    for (int first = 0; first < n && result == 0;)
+    {
+        size_t base = patternRowOffset(shape, n, first);
+        int last = rowAtOffset(shape, n, first + 1, n, base + capacity + 1);
+        if (patternRowOffset(shape, n, last) - base > capacity)
+            last--;
+
+        size_t bytes = patternRowOffset(shape, n, last) - base;
+        patternRasterize(shape, n, first, last, window, threads);
+        result = fwrite(window, 1, bytes, out) == bytes ? 0 : -1;
+        first = last;
+    }
+    free(window);
+    return result;
+}
+
+int patternWrite(int fd, PatternShape shape, int n, int threads)
+{
+    if (n <= 0)
+        return 0;
+
+    int mapped = mapPattern(fd, shape, n, threads);
+    if (mapped <= 0)
+        return mapped;
+    return patternWriteRows(fd, shape, n);
+}
+
+int patternWriteSink(OutputSink *sink, PatternShape shape, int n)
+{
+    if (n <= 0)
+        return 0;
+
+    if (sinkIsPlainFd(sink))
+    {
+        /* failures are kept in the sink, so sinkClose() reports them too */
+        if (sinkFlush(sink) != 0 || patternWrite(sink->fd, shape, n, 0) != 0)
+            sink->error = 1;
+        return sink->error ? -1 : 0;
+    }
+
+    for (int first = 0; first < n;)
+    {
+        /* the rows that fit in the room left, or one row (sinkReserve() makes room) */
+        size_t base = patternRowOffset(shape, n, first);
+        size_t room = sink->capacity - sink->used;
+        int last = rowAtOffset(shape, n, first + 1, n, base + room + 1);
+        if (last > first + 1 && patternRowOffset(shape, n, last) - base > room)
+            last--;
+
+        size_t bytes = patternRowOffset(shape, n, last) - base;
+        patternRasterize(shape, n, first, last, sinkReserve(sink, bytes), 0);
+        sinkCommit(sink, bytes);
+        first = last;
+    }
+    return sink->error ? -1 : 0;
+}
+
+int patternPrint(FILE *out, PatternShape shape, int n)
+{
+    if (n <= 0)
+        return 0;
+    if (fflush(out) != 0)
+        return -1;
+
+    int fd = fileno(out);
+    if (fd < 0)
+        return writeWindows(out, shape, n, 0);
+    return patternWrite(fd, shape, n, 0);
+}
@@ -0,0 +1,168 @@
+/**
+ * @file pattern_utils.h
+ * @brief Rasterizing the star patterns into a text canvas
+ * @version 1.0
+ * @date 2024
+ *
+ * A canvas is the exact text of the pattern: rows are stored one after the
+ * other, each ending in '\n', with no padding. Every row's offset has a
+ * closed form, so rows can be filled independently (and in parallel) with
+ * memcpy/memset spans, and the canvas is written out as it is.
+ *
+ * When the output cannot be mapped, the canvas is not built at all: each
+ * distinct row is computed once into a PatternRows template and every row
+ * is handed to writev() as a slice of it, so the work done here grows with
+ * the number of rows and not with the number of cells.
+ */
+
+#ifndef PATTERN_UTILS_H
+#define PATTERN_UTILS_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <sys/uio.h>
+#include "output_sink.h"
+
+/**
+ * @brief Canvas bytes below which rasterizing stays on the calling thread
+ */
+#define PATTERN_PARALLEL_MIN (1 << 20)
+
+/**
+ * @brief Bytes rasterized and written at a time when the output is not mapped
+ */
+#define PATTERN_WINDOW_BYTES (8 << 20)
+
+/**
+ * @brief Most slices handed to one writev() call (IOV_MAX on Linux)
+ */
+#define PATTERN_IOVECS 1024
+
+/**
+ * @brief Shapes the pattern programs print
+ */
+typedef enum {
+    PATTERN_HALF_PYRAMID,   /* row i (from 0): i + 1 "* " cells */
+    PATTERN_TRIANGLE,       /* row i: n - 1 - i spaces, then i + 1 "* " cells */
+    PATTERN_HOLLOW_SQUARE   /* n rows of n cells, "S " on the border, "  " inside */
+} PatternShape;
+
+/**
+ * @brief Type for the distinct rows of a pattern, each computed once
+ *
+ * Every row is a slice of text followed by "\n":
+ * - half pyramid: row i is the first 2(i + 1) bytes of n "* " cells,
+ *   since each row is a prefix of the next
+ * - triangle: row i is the n + i + 1 bytes at offset i of n - 1 blanks
+ *   followed by n "* " cells
+ * - hollow square: the border row or the interior row (newline included)
+ */
+typedef struct {
+    PatternShape shape;
+    int n;
+    char *text;
+    size_t length;
+} PatternRows;
+
+/**
+ * @brief Offset of a row in the canvas
+ * @param shape Shape of the pattern
+ * @param n Number of rows
+ * @param row Row index, 0..n (n gives the canvas size)
+ * @return Byte offset of the row
+ */
+size_t patternRowOffset(PatternShape shape, int n, int row);
+
+/**
+ * @brief Size of the whole canvas
+ * @param shape Shape of the pattern
+ * @param n Number of rows (0 or less for an empty pattern)
+ * @return Bytes of text the pattern prints
+ */
+size_t patternSize(PatternShape shape, int n);
+
+/**
+ * @brief Fills rows first..last-1 of a pattern
+ * @param shape Shape of the pattern
+ * @param n Number of rows
+ * @param first First row to fill
+ * @param last One past the last row to fill
+ * @param canvas Where row first goes; must hold
+ *        patternRowOffset(last) - patternRowOffset(first) bytes
+ * @param threads Threads to split the rows over (0 for one per CPU)
+ */
+void patternRasterize(PatternShape shape, int n, int first, int last, char *canvas, int threads);
+
+/**
+ * @brief Builds the row templates of a pattern
+ * @param rows Templates to initialize
+ * @param shape Shape of the pattern
+ * @param n Number of rows
+ */
+void patternRowsInit(PatternRows *rows, PatternShape shape, int n);
+
+/**
+ * @brief Releases row templates
+ * @param rows Templates to free
+ */
+void patternRowsFree(PatternRows *rows);
+
+/**
+ * @brief Gets the slices that make up one row
+ * @param rows Templates of the pattern
+ * @param row Row index, 0..n-1
+ * @param slices Filled with the row's slices, in order
+ * @return Number of slices (1 or 2)
+ */
+int patternRowSlices(const PatternRows *rows, int row, struct iovec slices[2]);
+
+/**
+ * @brief Writes a pattern as slices of its row templates with writev()
+ * @param fd Descriptor to write to
+ * @param shape Shape of the pattern
+ * @param n Number of rows
+ * @return 0 on success, -1 on a write error
+ */
+int patternWriteRows(int fd, PatternShape shape, int n);
+
+/**
+ * @brief Writes a pattern to a file descriptor
+ *
+ * A regular file opened for reading and writing is extended and the rows
+ * are rasterized straight into a shared mapping of it. Anything else gets
+ * the rows from patternWriteRows().
+ * @param fd Descriptor to write to, at its current offset
+ * @param shape Shape of the pattern
+ * @param n Number of rows
+ * @param threads Threads to rasterize with (0 for one per CPU)
+ * @return 0 on success, -1 on a write error
+ */
+int patternWrite(int fd, PatternShape shape, int n, int threads);
+
+/**
+ * @brief Writes a pattern through an output sink
+ *
+ * A sink that does plain write()s to a descriptor is flushed and bypassed
+ * for patternWrite(). Otherwise (memory, O_DIRECT, vmsplice()) the rows are
+ * rasterized straight into the sink's buffer, as many as fit at a time.
+ * @param sink Sink to write to
+ * @param shape Shape of the pattern
+ * @param n Number of rows
+ * @return 0 on success, -1 on a write error
+ */
+int patternWriteSink(OutputSink *sink, PatternShape shape, int n);
+
+/**
+ * @brief Prints a pattern to a stream
+ *
+ * Flushes the stream and writes to its descriptor with patternWrite(), or
+ * fwrite()s the canvas in PATTERN_WINDOW_BYTES windows for streams without
+ * one (e.g. fmemopen()).
+ * @param out Stream to print to
+ * @param shape Shape of the pattern
+ * @param n Number of rows
+ * @return 0 on success, -1 on a write error
+ */
+int patternPrint(FILE *out, PatternShape shape, int n);
+
+#endif /* PATTERN_UTILS_H */
@@ -9,65 +9,64 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <sched.h>
 #include <time.h>
 #include <ctype.h>
+#include <errno.h>
 #include <math.h>
-
-/**
- * @brief Color codes for console output
- */
-#define RED "\x1B[31m"
-#define GREEN "\x1B[32m"
-#define YELLOW "\x1B[33m"
-#define BLUE "\x1B[34m"
-#define MAGENTA "\x1B[35m"
-#define CYAN "\x1B[36m"
-#define WHITE "\x1B[37m"
-#define RESET "\x1B[0m"
-#define BOLD "\x1B[1m"
-
-/**
- * @brief Error codes
- */
-#define SUCCESS 0
-#define ERROR_INVALID_INPUT -1
-#define ERROR_DIVISION_BY_ZERO -2
-#define ERROR_MEMORY_ALLOCATION -3
-#define ERROR_FILE_OPERATION -4
-#define ERROR_ARRAY_BOUNDS -5
-
-/**
- * @brief Debug mode flag
- */
-#ifndef DEBUG
-#define DEBUG 0
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
 #endif
+#include "premium_utils.h"
 
 /**
- * @brief Debug print macro
+ * @brief One slot of the history ring
+ *
+ * sequence is ticket + 1 once the entry for that ticket is complete, and 0
+ * while a writer is filling the slot (or before it was ever used).
  */
-#define debug_print(fmt, ...)                             \
-    do                                                    \
-    {                                                     \
-        if (DEBUG)                                        \
-            fprintf(stderr, "%s:%d:%s(): " fmt, __FILE__, \
-                    __LINE__, __func__, __VA_ARGS__);     \
-    } while (0)
+typedef struct
+{
+    _Atomic uint64_t sequence;
+    HistoryEntry entry;
+} HistorySlot;
 
 /**
- * @brief Type for history entry
+ * @brief History ring buffer and its write cursor
+ *
+ * Writers take a ticket from g_historyHead and own slot ticket & mask, so
+ * recording never takes a lock and never moves the other entries.
  */
-typedef struct
-{
-    char operation[100];
-    time_t timestamp;
-} HistoryEntry;
+static HistorySlot g_defaultHistory[HISTORY_DEFAULT_CAPACITY];
+static HistorySlot *g_history = g_defaultHistory;
+static size_t g_historyMask = HISTORY_DEFAULT_CAPACITY - 1;
+static _Atomic uint64_t g_historyHead = 0;
 
 /**
- * @brief Global history array and count
+ * @brief Open history log, if any
+ *
+ * The log starts with a 16 byte header (magic, record size, reserved) and
+ * then holds fixed-size records in the order they were added, so records
+ * are sorted by timestamp and the n-th one sits at a known offset.
  */
-static HistoryEntry g_history[100];
-static int g_historyCount = 0;
+#define HISTORY_LOG_HEADER_SIZE 16
+
+static pthread_mutex_t g_logLock = PTHREAD_MUTEX_INITIALIZER;
+static int g_logFd = -1;
+static atomic_int g_logOpen = 0; // mirrors g_logFd >= 0 for the lock-free check in addToHistory()
+static char g_logPath[4096];
+static HistoryRecord g_logBuffer[HISTORY_LOG_BATCH];
+static size_t g_logBuffered = 0;
 
 /**
  * @brief Validates an integer input
@@ -192,302 +191,2345 @@ void printSuccess(const char *message)
  */
 void printWarning(const char *message)
 {
-    printf(YELLOW "%s" RESET "\n", message);
+    printf(YELLOW "%s" RESET "\n", message);
+}
+
+/**
+ * @brief Prints information message
+ * @param message The message to print
+ */
+void printInfo(const char *message)
+{
+    printf(BLUE "%s" RESET "\n", message);
+}
+
+/**
+ * @brief Writes buffered log records and syncs them (caller holds g_logLock)
+ * @return 0 on success, error code on failure
+ */
+static int writeHistoryLogLocked()
+{
+    const char *data = (const char *)g_logBuffer;
+    size_t remaining = g_logBuffered * sizeof(HistoryRecord);
+
+    g_logBuffered = 0;
+    while (remaining > 0)
+    {
+        ssize_t written = write(g_logFd, data, remaining);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            return ERROR_FILE_OPERATION;
+        data += written;
+        remaining -= (size_t)written;
+    }
+    return fdatasync(g_logFd) == 0 ? SUCCESS : ERROR_FILE_OPERATION;
+}
+
+/**
+ * @brief Starts appending every new history entry to a log file
+ * @param path Log file path
+ * @return 0 on success, error code on failure
+ */
+int openHistoryLog(const char *path)
+{
+    char header[HISTORY_LOG_HEADER_SIZE] = HISTORY_LOG_MAGIC;
+    uint32_t record_size = sizeof(HistoryRecord);
+    memcpy(header + 4, &record_size, sizeof(record_size));
+
+    if (strlen(path) >= sizeof(g_logPath))
+        return ERROR_INVALID_INPUT;
+
+    int fd = open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (fd < 0)
+        return ERROR_FILE_OPERATION;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return ERROR_FILE_OPERATION;
+    }
+
+    if (st.st_size == 0)
+    {
+        if (write(fd, header, sizeof(header)) != (ssize_t)sizeof(header))
+        {
+            close(fd);
+            return ERROR_FILE_OPERATION;
+        }
+    }
+    else
+    {
+        char existing[HISTORY_LOG_HEADER_SIZE];
+        if (pread(fd, existing, sizeof(existing), 0) != (ssize_t)sizeof(existing) ||
+            memcmp(existing, header, sizeof(header)) != 0)
+        {
+            close(fd);
+            return ERROR_FILE_OPERATION;
+        }
+
+        // Drop a record left half-written by a crash
+        off_t records = (st.st_size - HISTORY_LOG_HEADER_SIZE) / (off_t)sizeof(HistoryRecord);
+        off_t whole = HISTORY_LOG_HEADER_SIZE + records * (off_t)sizeof(HistoryRecord);
+        if (whole != st.st_size && ftruncate(fd, whole) != 0)
+        {
+            close(fd);
+            return ERROR_FILE_OPERATION;
+        }
+    }
+
+    closeHistoryLog();
+    pthread_mutex_lock(&g_logLock);
+    strcpy(g_logPath, path);
+    g_logBuffered = 0;
+    g_logFd = fd;
+    atomic_store_explicit(&g_logOpen, 1, memory_order_release);
+    pthread_mutex_unlock(&g_logLock);
+    return SUCCESS;
+}
+
+/**
+ * @brief Writes and syncs any buffered log records
+ * @return 0 on success, error code on failure
+ */
+int flushHistoryLog()
+{
+    int result = SUCCESS;
+
+    pthread_mutex_lock(&g_logLock);
+    if (g_logFd >= 0 && g_logBuffered > 0)
+        result = writeHistoryLogLocked();
+    pthread_mutex_unlock(&g_logLock);
+    return result;
+}
+
+/**
+ * @brief Flushes and closes the history log
+ */
+void closeHistoryLog()
+{
+    pthread_mutex_lock(&g_logLock);
+    if (g_logFd >= 0)
+    {
+        if (g_logBuffered > 0)
+            writeHistoryLogLocked();
+        close(g_logFd);
+        g_logFd = -1;
+        atomic_store_explicit(&g_logOpen, 0, memory_order_release);
+    }
+    pthread_mutex_unlock(&g_logLock);
+}
+
+/**
+ * @brief Maps a history log file for reading
+ * @param log Log to fill in
+ * @param path Log file path
+ * @return 0 on success, error code on failure
+ */
+int mapHistoryLog(HistoryLog *log, const char *path)
+{
+    log->records = NULL;
+    log->count = 0;
+    log->map = NULL;
+    log->map_size = 0;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return ERROR_FILE_OPERATION;
+
+    struct stat st;
+    char header[HISTORY_LOG_HEADER_SIZE];
+    uint32_t record_size;
+    if (fstat(fd, &st) != 0 || st.st_size < HISTORY_LOG_HEADER_SIZE ||
+        pread(fd, header, sizeof(header), 0) != (ssize_t)sizeof(header))
+    {
+        close(fd);
+        return ERROR_FILE_OPERATION;
+    }
+    memcpy(&record_size, header + 4, sizeof(record_size));
+    if (memcmp(header, HISTORY_LOG_MAGIC, 4) != 0 || record_size != sizeof(HistoryRecord))
+    {
+        close(fd);
+        return ERROR_FILE_OPERATION;
+    }
+
+    size_t count = (size_t)(st.st_size - HISTORY_LOG_HEADER_SIZE) / sizeof(HistoryRecord);
+    if (count > 0)
+    {
+        // Pages are only faulted in as records are looked at
+        log->map_size = HISTORY_LOG_HEADER_SIZE + count * sizeof(HistoryRecord);
+        log->map = mmap(NULL, log->map_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (log->map == MAP_FAILED)
+        {
+            log->map = NULL;
+            close(fd);
+            return ERROR_FILE_OPERATION;
+        }
+        log->records = (const HistoryRecord *)((const char *)log->map + HISTORY_LOG_HEADER_SIZE);
+        log->count = count;
+    }
+    close(fd);
+    return SUCCESS;
+}
+
+/**
+ * @brief Unmaps a history log
+ * @param log Log to release
+ */
+void unmapHistoryLog(HistoryLog *log)
+{
+    if (log->map != NULL)
+        munmap(log->map, log->map_size);
+    log->map = NULL;
+    log->records = NULL;
+    log->count = 0;
+}
+
+/**
+ * @brief Finds the first record at or after a time by binary search
+ * @param log Mapped log
+ * @param when Time to search for
+ * @return Index of the first record with timestamp >= when (count if none)
+ */
+size_t findHistoryRecord(const HistoryLog *log, time_t when)
+{
+    size_t lo = 0, hi = log->count;
+
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (log->records[mid].timestamp < (int64_t)when)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * @brief Displays the log records in [from, to), one page at a time
+ * @param path Log file path
+ * @param from First time to show
+ * @param to Time to stop at
+ * @param page_size Records per page (0 shows everything without pausing)
+ * @return 0 on success, error code on failure
+ */
+int displayHistoryLog(const char *path, time_t from, time_t to, size_t page_size)
+{
+    HistoryLog log;
+    int result = mapHistoryLog(&log, path);
+    if (result != SUCCESS)
+    {
+        printError(result);
+        return result;
+    }
+
+    size_t first = findHistoryRecord(&log, from);
+    size_t last = findHistoryRecord(&log, to);
+
+    printf(BOLD "\n===== Operation History (%zu of %zu) =====" RESET "\n",
+           last > first ? last - first : 0, log.count);
+    if (last <= first)
+        printf("No operations recorded yet.\n");
+
+    for (size_t i = first; i < last; i++)
+    {
+        const HistoryRecord *record = &log.records[i];
+        time_t timestamp = (time_t)record->timestamp;
+        char timeStr[26];
+
+        ctime_r(&timestamp, timeStr);
+        timeStr[24] = '\0'; // Remove newline
+        printf("%zu. [%s] %.*s\n", i + 1, timeStr, (int)sizeof(record->operation), record->operation);
+
+        if (page_size > 0 && (i - first + 1) % page_size == 0 && i + 1 < last)
+        {
+            printf("-- %zu more, Enter to continue, q to stop -- ", last - i - 1);
+            fflush(stdout);
+            int c = getchar();
+            if (c != '\n')
+            {
+                while (c != '\n' && c != EOF)
+                    c = getchar();
+                break;
+            }
+        }
+    }
+
+    unmapHistoryLog(&log);
+    return SUCCESS;
+}
+
+/**
+ * @brief Sets how many entries the history keeps
+ * @param capacity Number of entries, rounded up to a power of two
+ * @return 0 on success, error code on failure
+ */
+int setHistoryCapacity(size_t capacity)
+{
+    if (capacity == 0 || capacity > ((size_t)1 << 30))
+        return ERROR_INVALID_INPUT;
+
+    size_t rounded = 1;
+    while (rounded < capacity)
+        rounded <<= 1;
+
+    HistorySlot *slots = (HistorySlot *)safeAlloc(rounded * sizeof(HistorySlot));
+    for (size_t i = 0; i < rounded; i++)
+        atomic_init(&slots[i].sequence, 0);
+
+    if (g_history != g_defaultHistory)
+        free(g_history);
+    g_history = slots;
+    g_historyMask = rounded - 1;
+    atomic_store(&g_historyHead, 0);
+    return SUCCESS;
+}
+
+/**
+ * @brief Returns how many entries the history currently holds
+ * @return Number of entries, at most the capacity
+ */
+size_t getHistoryCount()
+{
+    uint64_t head = atomic_load_explicit(&g_historyHead, memory_order_acquire);
+    return head > g_historyMask ? g_historyMask + 1 : (size_t)head;
+}
+
+/**
+ * @brief Adds an entry to operation history
+ * @param operation The operation description
+ */
+void addToHistory(const char *operation)
+{
+    uint64_t ticket = atomic_fetch_add_explicit(&g_historyHead, 1, memory_order_relaxed);
+    HistorySlot *slot = &g_history[ticket & g_historyMask];
+
+    // Wait for the writer one lap behind on this slot (only happens when
+    // more threads are writing at once than the ring has slots)
+    uint64_t previous = ticket > g_historyMask ? ticket - g_historyMask : 0;
+    while (atomic_load_explicit(&slot->sequence, memory_order_acquire) != previous)
+        sched_yield();
+
+    atomic_store_explicit(&slot->sequence, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    size_t len = strnlen(operation, sizeof(slot->entry.operation) - 1);
+    memcpy(slot->entry.operation, operation, len);
+    slot->entry.operation[len] = '\0';
+    slot->entry.timestamp = time(NULL);
+
+    atomic_store_explicit(&slot->sequence, ticket + 1, memory_order_release);
+
+    // Without a log this stays lock-free. g_logFd itself is only read under
+    // the lock, since closeHistoryLog() may have run since the check
+    if (!atomic_load_explicit(&g_logOpen, memory_order_acquire))
+        return;
+
+    pthread_mutex_lock(&g_logLock);
+    if (g_logFd >= 0)
+    {
+        HistoryRecord *record = &g_logBuffer[g_logBuffered++];
+        memset(record, 0, sizeof(*record));
+        // Stamped under the lock so the file stays sorted by time
+        record->timestamp = (int64_t)time(NULL);
+        // From the caller's string: the slot may already be reused by a writer a lap ahead
+        memcpy(record->operation, operation, len);
+        if (g_logBuffered == HISTORY_LOG_BATCH)
+            writeHistoryLogLocked();
+    }
+    pthread_mutex_unlock(&g_logLock);
+}
+
+/**
+ * @brief Displays the operation history
+ */
+void displayHistory()
+{
+    char path[sizeof(g_logPath)];
+    int logging;
+
+    pthread_mutex_lock(&g_logLock);
+    logging = g_logFd >= 0;
+    if (logging)
+        strcpy(path, g_logPath);
+    pthread_mutex_unlock(&g_logLock);
+
+    if (logging)
+    {
+        flushHistoryLog();
+        displayHistoryLog(path, 0, (time_t)INT64_MAX, HISTORY_LOG_PAGE_SIZE);
+        return;
+    }
+
+    printf(BOLD "\n===== Operation History =====" RESET "\n");
+
+    uint64_t head = atomic_load_explicit(&g_historyHead, memory_order_acquire);
+    uint64_t count = head > g_historyMask ? g_historyMask + 1 : head;
+
+    if (count == 0)
+    {
+        printf("No operations recorded yet.\n");
+        return;
+    }
+
+    // Oldest to newest; entries being rewritten while we read are skipped
+    int shown = 0;
+    for (uint64_t ticket = head - count; ticket < head; ticket++)
+    {
+        const HistorySlot *slot = &g_history[ticket & g_historyMask];
+        HistoryEntry entry;
+
+        uint64_t before = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        entry = slot->entry;
+        atomic_thread_fence(memory_order_acquire);
+        uint64_t after = atomic_load_explicit(&slot->sequence, memory_order_relaxed);
+        if (before != ticket + 1 || after != before)
+            continue;
+
+        char timeStr[26];
+        ctime_r(&entry.timestamp, timeStr);
+        timeStr[24] = '\0'; // Remove newline
+        printf("%d. [%s] %s\n", ++shown, timeStr, entry.operation);
+    }
+}
+
+/**
+ * @brief Clears the console screen
+ */
+void clearScreen()
+{
+#ifdef _WIN32
+    system("cls");
+#else
+    system("clear");
+#endif
+}
+
+/**
+ * @brief Grows a buffer to hold at least needed bytes
+ */
+static void growBuffer(char **buffer, size_t *capacity, size_t needed)
+{
+    if (needed <= *capacity)
+        return;
+
+    size_t grown = *capacity > 0 ? *capacity : 256;
+    while (grown < needed)
+        grown *= 2;
+
+    char *data = (char *)realloc(*buffer, grown);
+    if (data == NULL)
+    {
+        printf(RED "Memory allocation failed.\n" RESET);
+        exit(ERROR_MEMORY_ALLOCATION);
+    }
+    *buffer = data;
+    *capacity = grown;
+}
+
+/**
+ * @brief Writes all bytes, retrying short writes
+ */
+static int writeAll(int fd, const char *data, size_t length)
+{
+    while (length > 0)
+    {
+        ssize_t written = write(fd, data, length);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            return ERROR_FILE_OPERATION;
+        data += written;
+        length -= (size_t)written;
+    }
+    return SUCCESS;
+}
+
+/**
+ * @brief Initializes a frame buffer
+ * @param frame Frame buffer to initialize
+ * @param fd Descriptor frames are written to
+ * @param in_place 1 to redraw each frame over the previous one
+ * @param capacity Initial buffer size in bytes (grows if needed)
+ */
+void frameBufferInit(FrameBuffer *frame, int fd, int in_place, size_t capacity)
+{
+    memset(frame, 0, sizeof(*frame));
+    frame->fd = fd;
+    frame->in_place = in_place;
+    growBuffer(&frame->data, &frame->capacity, capacity);
+    growBuffer(&frame->output, &frame->output_capacity, capacity);
+    if (in_place)
+        growBuffer(&frame->previous, &frame->previous_capacity, capacity);
+}
+
+/**
+ * @brief Starts a new frame, discarding anything appended since the last emit
+ * @param frame Frame buffer to reset
+ */
+void frameBufferBegin(FrameBuffer *frame)
+{
+    frame->length = 0;
+}
+
+/**
+ * @brief Appends bytes to the frame
+ * @param frame Frame buffer to append to
+ * @param data Bytes to append
+ * @param length Number of bytes
+ */
+void frameBufferAppend(FrameBuffer *frame, const char *data, size_t length)
+{
+    growBuffer(&frame->data, &frame->capacity, frame->length + length);
+    memcpy(frame->data + frame->length, data, length);
+    frame->length += length;
+}
+
+/**
+ * @brief Appends a cell (e.g. "#" or a multi-byte block character) count times
+ * @param frame Frame buffer to append to
+ * @param cell Bytes of one cell
+ * @param cell_length Number of bytes per cell
+ * @param count Number of cells
+ */
+void frameBufferAppendRepeat(FrameBuffer *frame, const char *cell, size_t cell_length, size_t count)
+{
+    size_t total = cell_length * count;
+    if (total == 0)
+        return;
+
+    growBuffer(&frame->data, &frame->capacity, frame->length + total);
+    char *out = frame->data + frame->length;
+    if (cell_length == 1)
+    {
+        memset(out, cell[0], total);
+    }
+    else
+    {
+        // Copy one cell, then keep doubling what is already there
+        size_t done = cell_length;
+        memcpy(out, cell, cell_length);
+        while (done < total)
+        {
+            size_t chunk = done < total - done ? done : total - done;
+            memcpy(out + done, out, chunk);
+            done += chunk;
+        }
+    }
+    frame->length += total;
+}
+
+/**
+ * @brief Appends formatted text to the frame
+ * @param frame Frame buffer to append to
+ * @param format Format string
+ * @param ... Additional arguments for format
+ */
+void frameBufferPrintf(FrameBuffer *frame, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int needed = vsnprintf(frame->data + frame->length, frame->capacity - frame->length, format, args);
+    va_end(args);
+
+    if (needed < 0)
+        return;
+    if ((size_t)needed >= frame->capacity - frame->length)
+    {
+        growBuffer(&frame->data, &frame->capacity, frame->length + needed + 1);
+        va_start(args, format);
+        vsnprintf(frame->data + frame->length, frame->capacity - frame->length, format, args);
+        va_end(args);
+    }
+    frame->length += (size_t)needed;
+}
+
+static void outputAppend(FrameBuffer *frame, const char *data, size_t length)
+{
+    growBuffer(&frame->output, &frame->output_capacity, frame->output_length + length);
+    memcpy(frame->output + frame->output_length, data, length);
+    frame->output_length += length;
+}
+
+static void outputEscape(FrameBuffer *frame, size_t count, char command)
+{
+    char escape[32];
+    int length = snprintf(escape, sizeof(escape), "\x1B[%zu%c", count, command);
+    outputAppend(frame, escape, (size_t)length);
+}
+
+/**
+ * @brief Counts the terminal columns in a run of UTF-8 bytes
+ *
+ * CSI escape sequences (colours and the like) take up no columns.
+ */
+static size_t countColumns(const char *text, size_t length)
+{
+    size_t columns = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        if (text[i] == '\x1B' && i + 1 < length && text[i + 1] == '[')
+        {
+            // parameters and intermediates run up to a final byte in 0x40..0x7E
+            for (i += 2; i < length && ((unsigned char)text[i] < 0x40 || (unsigned char)text[i] > 0x7E); i++)
+                ;
+            continue;
+        }
+        columns += ((unsigned char)text[i] & 0xC0) != 0x80;
+    }
+    return columns;
+}
+
+/**
+ * @brief Builds the escape sequences that turn the previous frame into the new one
+ *
+ * The cursor is assumed to be where the previous frame left it: at the end
+ * of its last line. Unchanged lines are stepped over, changed lines are
+ * rewritten from their first differing character. Changed lines holding
+ * escape sequences are rewritten whole, so skipped text cannot hide a
+ * colour change.
+ */
+static void buildFrameDiff(FrameBuffer *frame)
+{
+    const char *old_text = frame->previous, *old_end = frame->previous + frame->previous_length;
+    const char *new_text = frame->data, *new_end = frame->data + frame->length;
+    size_t old_lines = 1, line = 0;
+
+    for (const char *p = old_text; p < old_end; p++)
+        old_lines += *p == '\n';
+
+    outputAppend(frame, "\r", 1);
+    if (old_lines > 1)
+        outputEscape(frame, old_lines - 1, 'A');
+
+    const char *old_line = old_text, *new_line = new_text;
+    size_t last_columns = 0;
+    int last_rewritten = 0;
+    for (;;)
+    {
+        const char *old_stop = old_line ? memchr(old_line, '\n', old_end - old_line) : NULL;
+        const char *new_stop = memchr(new_line, '\n', new_end - new_line);
+        size_t old_length = old_line ? (size_t)((old_stop ? old_stop : old_end) - old_line) : 0;
+        size_t new_length = (size_t)((new_stop ? new_stop : new_end) - new_line);
+
+        if (line > 0)
+            outputAppend(frame, "\n", 1);
+
+        size_t same = 0;
+        if (old_line != NULL)
+        {
+            while (same < old_length && same < new_length && old_line[same] == new_line[same])
+                same++;
+            while (same > 0 && same < new_length && ((unsigned char)new_line[same] & 0xC0) == 0x80)
+                same--; // back up to the start of a UTF-8 character
+        }
+
+        int changed = old_line == NULL || same < old_length || same < new_length;
+        int escaped = memchr(new_line, '\x1B', new_length) != NULL ||
+                      (old_line != NULL && memchr(old_line, '\x1B', old_length) != NULL);
+        if (escaped)
+            same = 0;
+
+        // With equal lengths the unchanged tail can be left alone too
+        size_t end = new_length;
+        if (old_line != NULL && old_length == new_length && !escaped)
+        {
+            while (end > same && old_line[end - 1] == new_line[end - 1])
+                end--;
+            while (end < new_length && ((unsigned char)new_line[end] & 0xC0) == 0x80)
+                end++;
+        }
+
+        last_rewritten = changed && end == new_length;
+        last_columns = countColumns(new_line, new_length);
+        if (changed)
+        {
+            size_t columns = countColumns(new_line, same);
+            if (columns > 0)
+                outputEscape(frame, columns, 'C');
+            outputAppend(frame, new_line + same, end - same);
+            if (old_line != NULL && countColumns(old_line, old_length) > last_columns)
+                outputAppend(frame, "\x1B[K", 3);
+        }
+
+        line++;
+        old_line = old_stop ? old_stop + 1 : NULL;
+        if (new_stop == NULL)
+            break;
+        new_line = new_stop + 1;
+    }
+
+    // Clear lines the new frame no longer covers, then come back up
+    size_t extra = old_lines > line ? old_lines - line : 0;
+    for (size_t i = 0; i < extra; i++)
+        outputAppend(frame, "\n\x1B[2K", 5);
+    if (extra > 0)
+        outputEscape(frame, extra, 'A');
+    if (!last_rewritten || extra > 0)
+    {
+        outputAppend(frame, "\r", 1);
+        if (last_columns > 0)
+            outputEscape(frame, last_columns, 'C');
+    }
+}
+
+/**
+ * @brief Tells whether a rate-limited emit would be skipped right now
+ * @param frame Frame buffer to check
+ * @return 1 if the frame would be dropped, so building it can be skipped
+ */
+int frameBufferThrottled(const FrameBuffer *frame)
+{
+    return frame->last_emit_ns != 0 &&
+           monotonicNanos() - frame->last_emit_ns < 1000000000ULL / FRAME_RATE_HZ;
+}
+
+/**
+ * @brief Sends the frame with one write()
+ * @param frame Frame buffer to send
+ * @param force 0 to skip the frame if the last one went out less than 1/FRAME_RATE_HZ ago
+ * @return 1 if the frame was written, 0 if it was skipped or unchanged
+ */
+int frameBufferEmit(FrameBuffer *frame, int force)
+{
+    if (!force && frameBufferThrottled(frame))
+        return 0;
+
+    const char *bytes = frame->data;
+    size_t length = frame->length;
+
+    if (frame->in_place)
+    {
+        if (frame->has_previous && frame->previous_length == frame->length &&
+            memcmp(frame->previous, frame->data, frame->length) == 0)
+            return 0;
+
+        frame->output_length = 0;
+        if (frame->has_previous)
+        {
+            buildFrameDiff(frame);
+        }
+        else
+        {
+            outputAppend(frame, "\r", 1);
+            outputAppend(frame, frame->data, frame->length);
+        }
+        bytes = frame->output;
+        length = frame->output_length;
+
+        growBuffer(&frame->previous, &frame->previous_capacity, frame->length);
+        memcpy(frame->previous, frame->data, frame->length);
+        frame->previous_length = frame->length;
+        frame->has_previous = 1;
+    }
+
+    // Anything printf() still holds must come out first
+    if (frame->fd == STDOUT_FILENO)
+        fflush(stdout);
+    writeAll(frame->fd, bytes, length);
+    frame->last_emit_ns = monotonicNanos();
+    return 1;
+}
+
+/**
+ * @brief Releases a frame buffer
+ * @param frame Frame buffer to free
+ */
+void frameBufferFree(FrameBuffer *frame)
+{
+    free(frame->data);
+    free(frame->previous);
+    free(frame->output);
+    memset(frame, 0, sizeof(*frame));
+}
+
+/**
+ * @brief Shows a progress bar
+ * @param current Current progress
+ * @param total Total work to be done
+ * @param width Width of the progress bar
+ */
+void showProgress(int current, int total, int width)
+{
+    static FrameBuffer frame;
+    static int initialized = 0;
+
+    if (!initialized)
+    {
+        frameBufferInit(&frame, STDOUT_FILENO, 1, 256);
+        initialized = 1;
+    }
+
+    // Skip building frames the terminal would never get to show
+    int final = current >= total;
+    if (!final && frameBufferThrottled(&frame))
+        return;
+
+    float percent = (float)current / total;
+    int chars = (int)(width * percent);
+    if (chars < 0)
+        chars = 0;
+    if (chars > width)
+        chars = width;
+
+    frameBufferBegin(&frame);
+    frameBufferAppend(&frame, "[", 1);
+    frameBufferAppendRepeat(&frame, "#", 1, chars);
+    frameBufferAppendRepeat(&frame, " ", 1, width - chars);
+    frameBufferPrintf(&frame, "] %.1f%%", percent * 100);
+    frameBufferEmit(&frame, final);
+
+    // The next bar starts from scratch, wherever the cursor is by then
+    if (final)
+        frame.has_previous = 0;
+}
+
+/**
+ * @brief Appends a count with a K/M/G/T suffix
+ */
+static void appendScaled(FrameBuffer *frame, double value)
+{
+    static const char suffixes[] = " KMGT";
+    int i = 0;
+    while (value >= 1000.0 && i < 4)
+    {
+        value /= 1000.0;
+        i++;
+    }
+    if (i == 0)
+        frameBufferPrintf(frame, "%.0f", value);
+    else
+        frameBufferPrintf(frame, "%.2f%c", value, suffixes[i]);
+}
+
+/**
+ * @brief Builds one progress line into the reporter's frame
+ */
+static void buildProgressLine(ProgressReporter *progress, uint64_t done, double rate, int final)
+{
+    FrameBuffer *frame = &progress->frame;
+    const int width = 20;
+
+    frameBufferBegin(frame);
+    frameBufferPrintf(frame, "%s ", progress->label);
+    if (progress->total > 0)
+    {
+        double fraction = (double)done / progress->total;
+        if (fraction > 1.0)
+            fraction = 1.0;
+        int chars = (int)(width * fraction);
+        frameBufferAppend(frame, "[", 1);
+        frameBufferAppendRepeat(frame, "#", 1, chars);
+        frameBufferAppendRepeat(frame, " ", 1, width - chars);
+        frameBufferPrintf(frame, "] %5.1f%%  ", fraction * 100);
+        appendScaled(frame, (double)done);
+        frameBufferAppend(frame, "/", 1);
+        appendScaled(frame, (double)progress->total);
+    }
+    else
+    {
+        appendScaled(frame, (double)done);
+    }
+    frameBufferPrintf(frame, " %s  ", progress->unit);
+    appendScaled(frame, rate);
+    frameBufferPrintf(frame, " %s/s", progress->unit);
+
+    if (final)
+    {
+        frameBufferPrintf(frame, "  in %.2f s", (monotonicNanos() - progress->start_ns) / 1e9);
+    }
+    else if (progress->total > 0 && rate > 0 && done < progress->total)
+    {
+        uint64_t eta = (uint64_t)((progress->total - done) / rate);
+        frameBufferPrintf(frame, "  ETA %llu:%02u:%02u", (unsigned long long)(eta / 3600),
+                          (unsigned)(eta / 60 % 60), (unsigned)(eta % 60));
+    }
+}
+
+/**
+ * @brief Samples the counter and redraws the progress line
+ */
+static void reportProgress(ProgressReporter *progress)
+{
+    uint64_t now = monotonicNanos();
+    uint64_t done = atomic_load_explicit(&progress->done, memory_order_relaxed);
+    double seconds = (now - progress->last_ns) / 1e9;
+
+    if (seconds > 0)
+    {
+        // Smooth the per-interval rate so the ETA does not jump around
+        double current = (done - progress->last_done) / seconds;
+        progress->rate = progress->last_done == 0 && progress->rate == 0
+                             ? current
+                             : 0.7 * progress->rate + 0.3 * current;
+    }
+    progress->last_ns = now;
+    progress->last_done = done;
+
+    buildProgressLine(progress, done, progress->rate, 0);
+    frameBufferEmit(&progress->frame, 1);
+}
+
+static void *progressThread(void *arg)
+{
+    ProgressReporter *progress = (ProgressReporter *)arg;
+
+    pthread_mutex_lock(&progress->lock);
+    while (!progress->stopping)
+    {
+        struct timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        uint64_t ns = deadline.tv_nsec + progress->interval_ns;
+        deadline.tv_sec += ns / 1000000000ULL;
+        deadline.tv_nsec = ns % 1000000000ULL;
+
+        pthread_cond_timedwait(&progress->wake, &progress->lock, &deadline);
+        if (progress->stopping)
+            break;
+
+        pthread_mutex_unlock(&progress->lock);
+        reportProgress(progress);
+        pthread_mutex_lock(&progress->lock);
+    }
+    pthread_mutex_unlock(&progress->lock);
+    return NULL;
+}
+
+/**
+ * @brief Initializes a progress reporter
+ * @param progress Reporter to initialize
+ * @param label Text shown before the bar
+ * @param unit Name of the units counted (e.g. "guesses")
+ * @param total Expected number of units, or 0 if unknown
+ * @param interval_ms Time between reports (0 for PROGRESS_DEFAULT_INTERVAL_MS)
+ */
+void progressInit(ProgressReporter *progress, const char *label, const char *unit,
+                  uint64_t total, int interval_ms)
+{
+    memset(progress, 0, sizeof(*progress));
+    atomic_init(&progress->done, 0);
+    progress->total = total;
+    progress->label = label;
+    progress->unit = unit;
+    progress->interval_ns = (uint64_t)(interval_ms > 0 ? interval_ms : PROGRESS_DEFAULT_INTERVAL_MS) * 1000000ULL;
+}
+
+/**
+ * @brief Starts the background reporter thread
+ * @param progress Reporter to start
+ * @return SUCCESS or ERROR_INVALID_INPUT if the thread could not be created
+ */
+int progressStart(ProgressReporter *progress)
+{
+    pthread_condattr_t attr;
+
+    pthread_mutex_init(&progress->lock, NULL);
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&progress->wake, &attr);
+    pthread_condattr_destroy(&attr);
+
+    frameBufferInit(&progress->frame, STDERR_FILENO, 1, 256);
+    progress->start_ns = monotonicNanos();
+    progress->last_ns = progress->start_ns;
+    progress->stopping = 0;
+
+    if (pthread_create(&progress->thread, NULL, progressThread, progress) != 0)
+    {
+        pthread_cond_destroy(&progress->wake);
+        pthread_mutex_destroy(&progress->lock);
+        frameBufferFree(&progress->frame);
+        return ERROR_INVALID_INPUT;
+    }
+    progress->running = 1;
+    return SUCCESS;
+}
+
+/**
+ * @brief Stops the reporter thread and prints the final totals
+ * @param progress Reporter to stop
+ */
+void progressStop(ProgressReporter *progress)
+{
+    if (!progress->running)
+        return;
+
+    pthread_mutex_lock(&progress->lock);
+    progress->stopping = 1;
+    pthread_cond_signal(&progress->wake);
+    pthread_mutex_unlock(&progress->lock);
+    pthread_join(progress->thread, NULL);
+    progress->running = 0;
+
+    // The final line shows the average rate over the whole run
+    uint64_t done = atomic_load_explicit(&progress->done, memory_order_relaxed);
+    double seconds = (monotonicNanos() - progress->start_ns) / 1e9;
+    buildProgressLine(progress, done, seconds > 0 ? done / seconds : 0, 1);
+    frameBufferAppend(&progress->frame, "\n", 1);
+    frameBufferEmit(&progress->frame, 1);
+
+    pthread_cond_destroy(&progress->wake);
+    pthread_mutex_destroy(&progress->lock);
+    frameBufferFree(&progress->frame);
+}
+
+/**
+ * @brief Reads the monotonic clock
+ * @return Nanoseconds since an arbitrary fixed point
+ */
+uint64_t monotonicNanos()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Measures execution time of a single call to a function
+ * @param func Function pointer to measure
+ * @return Wall-clock execution time in seconds
+ */
+double measureExecutionTime(void (*func)(void))
+{
+    uint64_t start = monotonicNanos();
+    func();
+    return (double)(monotonicNanos() - start) / 1e9;
+}
+
+/**
+ * @brief Opens and starts the counters of a region
+ * @param region Region to start
+ * @param name Name printed with the results
+ * @return 0 if at least one counter is running, error code otherwise
+ */
+int perfRegionStart(PerfRegion *region, const char *name)
+{
+    int opened = 0;
+
+    region->name = name;
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+    {
+        region->fds[i] = -1;
+        region->values[i] = 0;
+    }
+
+#ifdef __linux__
+    static const uint64_t configs[PERF_EVENT_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES};
+
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+    {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = configs[i];
+        attr.disabled = 1;
+        attr.inherit = 1; // also count threads started inside the region
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        region->fds[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (region->fds[i] >= 0)
+            opened++;
+    }
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+    {
+        if (region->fds[i] >= 0)
+        {
+            ioctl(region->fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(region->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+
+    region->elapsed_ns = 0;
+    region->start_ns = monotonicNanos();
+    return opened > 0 ? SUCCESS : ERROR_FILE_OPERATION;
+}
+
+/**
+ * @brief Updates the values and elapsed time of a running region
+ * @param region Region to read
+ */
+void perfRegionRead(PerfRegion *region)
+{
+    region->elapsed_ns = monotonicNanos() - region->start_ns;
+
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+    {
+        uint64_t data[3]; // value, time enabled, time running
+        if (region->fds[i] < 0 || read(region->fds[i], data, sizeof(data)) != (ssize_t)sizeof(data))
+            continue;
+
+        // Scale up if the event only had a hardware counter part of the time
+        if (data[2] > 0 && data[2] < data[1])
+            region->values[i] = (uint64_t)((double)data[0] * data[1] / data[2]);
+        else
+            region->values[i] = data[0];
+    }
+}
+
+/**
+ * @brief Reads the final values of a region and closes its counters
+ * @param region Region to stop
+ */
+void perfRegionStop(PerfRegion *region)
+{
+    perfRegionRead(region);
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+    {
+        if (region->fds[i] >= 0)
+            close(region->fds[i]);
+    }
+}
+
+/**
+ * @brief Prints the values of a region on one line
+ * @param fp Stream to print to
+ * @param region Region to print
+ */
+void printPerfRegion(FILE *fp, const PerfRegion *region)
+{
+    static const char *labels[PERF_EVENT_COUNT] = {"cycles", "instructions", "cache-misses", "branch-misses"};
+
+    fprintf(fp, "[perf] %s: %.3f ms", region->name, region->elapsed_ns / 1e6);
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+    {
+        if (region->fds[i] >= 0)
+            fprintf(fp, ", %s %llu", labels[i], (unsigned long long)region->values[i]);
+        else
+            fprintf(fp, ", %s n/a", labels[i]);
+    }
+    if (region->fds[PERF_CYCLES] >= 0 && region->fds[PERF_INSTRUCTIONS] >= 0 && region->values[PERF_CYCLES] > 0)
+        fprintf(fp, ", IPC %.2f", (double)region->values[PERF_INSTRUCTIONS] / region->values[PERF_CYCLES]);
+    fprintf(fp, "\n");
+}
+
+static const void *volatile g_benchSink;
+
+/**
+ * @brief Reads a value through a volatile pointer (for DO_NOT_OPTIMIZE without GCC)
+ * @param value Value to read, or NULL
+ */
+void benchmarkSink(const void *value)
+{
+    g_benchSink = value;
+}
+
+/**
+ * @brief Times a number of back-to-back calls
+ */
+static uint64_t timeCalls(BenchFunction func, void *ctx, uint64_t iterations)
+{
+    uint64_t start = monotonicNanos();
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        func(ctx);
+        CLOBBER_MEMORY();
+    }
+    return monotonicNanos() - start;
+}
+
+static int compareDoubles(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Benchmarks a function
+ * @param name Name stored in the result
+ * @param func Function to run
+ * @param ctx Argument passed to every call
+ * @param samples Number of samples (0 for BENCH_DEFAULT_SAMPLES)
+ * @param result Receives the per-call timings
+ * @return 0 on success, error code on failure
+ */
+int runBenchmark(const char *name, BenchFunction func, void *ctx, int samples, BenchResult *result)
+{
+    if (func == NULL || result == NULL || samples < 0)
+        return ERROR_INVALID_INPUT;
+    if (samples == 0)
+        samples = BENCH_DEFAULT_SAMPLES;
+
+    // Warm caches, branch predictors and the CPU clock
+    uint64_t warmup_start = monotonicNanos();
+    while (monotonicNanos() - warmup_start < BENCH_WARMUP_NS)
+        timeCalls(func, ctx, 1);
+
+    uint64_t iterations = 1;
+    while (timeCalls(func, ctx, iterations) < BENCH_SAMPLE_NS && iterations < (1ULL << 40))
+        iterations *= 2;
+
+    double *times = (double *)safeAlloc(samples * sizeof(double));
+    double sum = 0.0;
+    for (int i = 0; i < samples; i++)
+    {
+        times[i] = (double)timeCalls(func, ctx, iterations) / (double)iterations;
+        sum += times[i];
+    }
+    qsort(times, samples, sizeof(double), compareDoubles);
+
+    double mean = sum / samples;
+    double squares = 0.0;
+    for (int i = 0; i < samples; i++)
+        squares += (times[i] - mean) * (times[i] - mean);
+
+    snprintf(result->name, sizeof(result->name), "%s", name != NULL ? name : "");
+    result->iterations = iterations;
+    result->samples = samples;
+    result->min_ns = times[0];
+    result->median_ns = samples % 2 ? times[samples / 2] : (times[samples / 2 - 1] + times[samples / 2]) / 2;
+    result->p99_ns = times[(int)ceil(0.99 * samples) - 1]; // nearest rank
+    result->mean_ns = mean;
+    result->stddev_ns = samples > 1 ? sqrt(squares / (samples - 1)) : 0.0;
+    result->bytes_per_call = 0.0;
+
+    free(times);
+    return SUCCESS;
+}
+
+/**
+ * @brief Prints benchmark results as a table, CSV or a JSON array
+ * @param fp Stream to print to
+ * @param results Results to print
+ * @param count Number of results
+ * @param format Output format
+ */
+void printBenchmarkResults(FILE *fp, const BenchResult results[], int count, BenchFormat format)
+{
+    switch (format)
+    {
+    case BENCH_FORMAT_CSV:
+        fprintf(fp, "name,samples,iterations,min_ns,median_ns,p99_ns,mean_ns,stddev_ns,gb_per_s\n");
+        for (int i = 0; i < count; i++)
+        {
+            const BenchResult *r = &results[i];
+            fprintf(fp, "\"%s\",%d,%llu,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n", r->name, r->samples,
+                    (unsigned long long)r->iterations, r->min_ns, r->median_ns, r->p99_ns, r->mean_ns, r->stddev_ns,
+                    r->bytes_per_call / r->median_ns);
+        }
+        break;
+    case BENCH_FORMAT_JSON:
+        fprintf(fp, "[\n");
+        for (int i = 0; i < count; i++)
+        {
+            const BenchResult *r = &results[i];
+            fprintf(fp, "  {\"name\": \"%s\", \"samples\": %d, \"iterations\": %llu, "
+                        "\"min_ns\": %.3f, \"median_ns\": %.3f, \"p99_ns\": %.3f, "
+                        "\"mean_ns\": %.3f, \"stddev_ns\": %.3f, \"gb_per_s\": %.3f}%s\n",
+                    r->name, r->samples, (unsigned long long)r->iterations, r->min_ns, r->median_ns,
+                    r->p99_ns, r->mean_ns, r->stddev_ns, r->bytes_per_call / r->median_ns,
+                    i + 1 < count ? "," : "");
+        }
+        fprintf(fp, "]\n");
+        break;
+    default:
+        fprintf(fp, BOLD "%-32s %12s %12s %12s %12s %8s" RESET "\n", "Benchmark", "min", "median", "p99", "stddev", "GB/s");
+        for (int i = 0; i < count; i++)
+        {
+            const BenchResult *r = &results[i];
+            fprintf(fp, "%-32s %10.1fns %10.1fns %10.1fns %10.1fns", r->name, r->min_ns,
+                    r->median_ns, r->p99_ns, r->stddev_ns);
+            if (r->bytes_per_call > 0)
+                fprintf(fp, " %8.2f\n", r->bytes_per_call / r->median_ns);
+            else
+                fprintf(fp, " %8s\n", "-");
+        }
+    }
+}
+
+/**
+ * @brief Saves result to a file
+ * @param filename File to save to
+ * @param format Format string
+ * @param ... Additional arguments for format
+ * @return 0 on success, error code on failure
+ */
+int saveToFile(const char *filename, const char *format, ...)
+{
+    FILE *fp = fopen(filename, "w");
+    if (fp == NULL)
+    {
+        printError(ERROR_FILE_OPERATION);
+        return ERROR_FILE_OPERATION;
+    }
+
+    va_list args;
+    va_start(args, format);
+    vfprintf(fp, format, args);
+    va_end(args);
+
+    fclose(fp);
+
+    char message[100];
+    sprintf(message, "Result saved to %s", filename);
+    printSuccess(message);
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Loads data from a file
+ * @param filename File to load from
+ * @param buffer Buffer to store data
+ * @param size Size of buffer
+ * @return 0 on success, error code on failure
+ */
+int loadFromFile(const char *filename, char *buffer, size_t size)
+{
+    FILE *fp = fopen(filename, "r");
+    if (fp == NULL)
+    {
+        printError(ERROR_FILE_OPERATION);
+        return ERROR_FILE_OPERATION;
+    }
+
+    size_t read_size = fread(buffer, 1, size - 1, fp);
+    buffer[read_size] = '\0';
+
+    fclose(fp);
+
+    char message[100];
+    sprintf(message, "Data loaded from %s", filename);
+    printSuccess(message);
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Displays a menu and gets user choice
+ * @param title Menu title
+ * @param options Array of option strings
+ * @param num_options Number of options
+ * @return User's choice (1-based index)
+ */
+int displayMenu(const char *title, const char *options[], int num_options)
+{
+    printf(BOLD "\n===== %s =====" RESET "\n", title);
+
+    for (int i = 0; i < num_options; i++)
+    {
+        printf("%d. %s\n", i + 1, options[i]);
+    }
+    printf("0. Exit\n");
+
+    return validateInteger("Enter your choice: ", 0, num_options);
+}
+
+/**
+ * @brief Gets current date and time as a string
+ * @param buffer Buffer to store the date string
+ * @param size Size of buffer
+ */
+void getCurrentDateTime(char *buffer, size_t size)
+{
+    time_t now = time(NULL);
+    strftime(buffer, size, "%Y-%m-%d %H:%M:%S", localtime(&now));
+}
+
+/**
+ * @brief Generates a random integer in a range
+ * @param min Minimum value (inclusive)
+ * @param max Maximum value (inclusive)
+ * @return Random integer
+ */
+int getRandomInt(int min, int max)
+{
+    static int seeded = 0;
+
+    if (!seeded)
+    {
+        srand(time(NULL));
+        seeded = 1;
+    }
+
+    return min + rand() % (max - min + 1);
+}
+
+/**
+ * @brief Swaps two integers
+ * @param a Pointer to first integer
+ * @param b Pointer to second integer
+ */
+void swapInt(int *a, int *b)
+{
+    int temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+/**
+ * @brief Largest range one stats kernel handles, so lane indices fit in 32 bits
+ */
+#define STATS_BLOCK ((size_t)1 << 30)
+
+typedef void (*StatsKernel)(const int *arr, size_t n, ArrayStats *out);
+
+/**
+ * @brief Folds per-lane minima and maxima into out, preferring lower indices on ties
+ */
+static void reduceStatsLanes(const int mins[], const uint32_t min_index[], const int maxs[],
+                             const uint32_t max_index[], int lanes, ArrayStats *out)
+{
+    out->min = mins[0];
+    out->argmin = min_index[0];
+    out->max = maxs[0];
+    out->argmax = max_index[0];
+    for (int l = 1; l < lanes; l++)
+    {
+        if (mins[l] < out->min || (mins[l] == out->min && min_index[l] < out->argmin))
+        {
+            out->min = mins[l];
+            out->argmin = min_index[l];
+        }
+        if (maxs[l] > out->max || (maxs[l] == out->max && max_index[l] < out->argmax))
+        {
+            out->max = maxs[l];
+            out->argmax = max_index[l];
+        }
+    }
+}
+
+/**
+ * @brief Adds arr[from..n-1] to stats already covering arr[0..from-1]
+ */
+static void statsTail(const int *arr, size_t from, size_t n, ArrayStats *out)
+{
+    for (size_t i = from; i < n; i++)
+    {
+        if (arr[i] < out->min)
+        {
+            out->min = arr[i];
+            out->argmin = i;
+        }
+        if (arr[i] > out->max)
+        {
+            out->max = arr[i];
+            out->argmax = i;
+        }
+        out->sum += arr[i];
+    }
+}
+
+static void statsScalar(const int *arr, size_t n, ArrayStats *out)
+{
+    out->min = out->max = arr[0];
+    out->argmin = out->argmax = 0;
+    out->sum = arr[0];
+    statsTail(arr, 1, n, out);
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_X86_KERNELS 1
+#include <immintrin.h>
+
+/*
+ * The SIMD kernels keep a running minimum and maximum per lane together with
+ * the index where each was seen (replaced only on a strict improvement, so
+ * the first occurrence wins), and sum each lane into 64-bit accumulators.
+ */
+__attribute__((target("sse2"))) static void statsSse2(const int *arr, size_t n, ArrayStats *out)
+{
+    if (n < 4)
+    {
+        statsScalar(arr, n, out);
+        return;
+    }
+
+    const __m128i step = _mm_set1_epi32(4);
+    __m128i vmin = _mm_loadu_si128((const __m128i *)arr);
+    __m128i vmax = vmin;
+    __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+    __m128i imin = index, imax = index;
+    __m128i sign = _mm_cmpgt_epi32(_mm_setzero_si128(), vmin);
+    __m128i sum = _mm_add_epi64(_mm_unpacklo_epi32(vmin, sign), _mm_unpackhi_epi32(vmin, sign));
+    size_t i = 4;
+
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(arr + i));
+        index = _mm_add_epi32(index, step);
+
+        // SSE2 has no blend or 32-bit min/max: select with and/andnot/or
+        __m128i lt = _mm_cmpgt_epi32(vmin, v);
+        vmin = _mm_or_si128(_mm_and_si128(lt, v), _mm_andnot_si128(lt, vmin));
+        imin = _mm_or_si128(_mm_and_si128(lt, index), _mm_andnot_si128(lt, imin));
+        __m128i gt = _mm_cmpgt_epi32(v, vmax);
+        vmax = _mm_or_si128(_mm_and_si128(gt, v), _mm_andnot_si128(gt, vmax));
+        imax = _mm_or_si128(_mm_and_si128(gt, index), _mm_andnot_si128(gt, imax));
+
+        sign = _mm_cmpgt_epi32(_mm_setzero_si128(), v);
+        sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(v, sign));
+        sum = _mm_add_epi64(sum, _mm_unpackhi_epi32(v, sign));
+    }
+
+    int mins[4], maxs[4];
+    uint32_t min_index[4], max_index[4];
+    int64_t sums[2];
+    _mm_storeu_si128((__m128i *)mins, vmin);
+    _mm_storeu_si128((__m128i *)maxs, vmax);
+    _mm_storeu_si128((__m128i *)min_index, imin);
+    _mm_storeu_si128((__m128i *)max_index, imax);
+    _mm_storeu_si128((__m128i *)sums, sum);
+
+    reduceStatsLanes(mins, min_index, maxs, max_index, 4, out);
+    out->sum = sums[0] + sums[1];
+    statsTail(arr, i, n, out);
+}
+
+__attribute__((target("avx2"))) static void statsAvx2(const int *arr, size_t n, ArrayStats *out)
+{
+    if (n < 8)
+    {
+        statsScalar(arr, n, out);
+        return;
+    }
+
+    const __m256i step = _mm256_set1_epi32(8);
+    __m256i vmin = _mm256_loadu_si256((const __m256i *)arr);
+    __m256i vmax = vmin;
+    __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i imin = index, imax = index;
+    __m256i sum_lo = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(vmin));
+    __m256i sum_hi = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(vmin, 1));
+    size_t i = 8;
+
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(arr + i));
+        index = _mm256_add_epi32(index, step);
+
+        __m256i lt = _mm256_cmpgt_epi32(vmin, v);
+        vmin = _mm256_blendv_epi8(vmin, v, lt);
+        imin = _mm256_blendv_epi8(imin, index, lt);
+        __m256i gt = _mm256_cmpgt_epi32(v, vmax);
+        vmax = _mm256_blendv_epi8(vmax, v, gt);
+        imax = _mm256_blendv_epi8(imax, index, gt);
+
+        sum_lo = _mm256_add_epi64(sum_lo, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        sum_hi = _mm256_add_epi64(sum_hi, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+
+    int mins[8], maxs[8];
+    uint32_t min_index[8], max_index[8];
+    int64_t sums[4];
+    _mm256_storeu_si256((__m256i *)mins, vmin);
+    _mm256_storeu_si256((__m256i *)maxs, vmax);
+    _mm256_storeu_si256((__m256i *)min_index, imin);
+    _mm256_storeu_si256((__m256i *)max_index, imax);
+    _mm256_storeu_si256((__m256i *)sums, _mm256_add_epi64(sum_lo, sum_hi));
+
+    reduceStatsLanes(mins, min_index, maxs, max_index, 8, out);
+    out->sum = sums[0] + sums[1] + sums[2] + sums[3];
+    statsTail(arr, i, n, out);
+}
+#endif
+
+static StatsKernel g_statsKernel = NULL;
+static const char *g_statsKernelName = "scalar";
+
+/**
+ * @brief Picks the array statistics kernel
+ * @param name "scalar", "sse2" or "avx2", or NULL for the widest the CPU supports
+ * @return Name of the kernel in use
+ */
+const char *selectArrayStatsKernel(const char *name)
+{
+#ifdef HAVE_X86_KERNELS
+    __builtin_cpu_init();
+    int avx2 = __builtin_cpu_supports("avx2");
+    int sse2 = __builtin_cpu_supports("sse2");
+
+    if (name != NULL && strcmp(name, "scalar") == 0)
+        avx2 = sse2 = 0;
+    else if (name != NULL && strcmp(name, "sse2") == 0)
+        avx2 = 0;
+
+    if (avx2)
+    {
+        g_statsKernelName = "avx2";
+        g_statsKernel = statsAvx2;
+        return g_statsKernelName;
+    }
+    if (sse2)
+    {
+        g_statsKernelName = "sse2";
+        g_statsKernel = statsSse2;
+        return g_statsKernelName;
+    }
+#else
+    (void)name;
+#endif
+    g_statsKernelName = "scalar";
+    g_statsKernel = statsScalar;
+    return g_statsKernelName;
+}
+
+static pthread_once_t g_statsKernelOnce = PTHREAD_ONCE_INIT;
+
+static void selectDefaultStatsKernel()
+{
+    if (g_statsKernel == NULL)
+        selectArrayStatsKernel(NULL);
+}
+
+/**
+ * @brief Merges the stats of a later range (starting at offset) into out
+ */
+static void mergeStats(ArrayStats *out, const ArrayStats *part, size_t offset)
+{
+    if (part->min < out->min)
+    {
+        out->min = part->min;
+        out->argmin = part->argmin + offset;
+    }
+    if (part->max > out->max)
+    {
+        out->max = part->max;
+        out->argmax = part->argmax + offset;
+    }
+    out->sum += part->sum;
+}
+
+/**
+ * @brief Runs the kernel over a range of any length, STATS_BLOCK at a time
+ */
+static void statsRange(const int *arr, size_t n, ArrayStats *out)
+{
+    g_statsKernel(arr, n < STATS_BLOCK ? n : STATS_BLOCK, out);
+    for (size_t offset = STATS_BLOCK; offset < n; offset += STATS_BLOCK)
+    {
+        ArrayStats part;
+        size_t length = n - offset < STATS_BLOCK ? n - offset : STATS_BLOCK;
+        g_statsKernel(arr + offset, length, &part);
+        mergeStats(out, &part, offset);
+    }
+}
+
+typedef struct
+{
+    const int *arr;
+    size_t n;
+    ArrayStats stats;
+} StatsTask;
+
+static void *statsWorker(void *arg)
+{
+    StatsTask *task = (StatsTask *)arg;
+    statsRange(task->arr, task->n, &task->stats);
+    return NULL;
+}
+
+/**
+ * @brief Computes min, max, sum, mean and their positions in one pass
+ * @param arr Array of integers
+ * @param size Size of array
+ * @param stats Receives the statistics
+ * @return 0 on success, error code on failure
+ */
+int arrayStats(const int arr[], size_t size, ArrayStats *stats)
+{
+    if (arr == NULL || size == 0 || stats == NULL)
+        return ERROR_INVALID_INPUT;
+
+    pthread_once(&g_statsKernelOnce, selectDefaultStatsKernel);
+
+    size_t threads = 1;
+    if (size >= ARRAY_STATS_PARALLEL_MIN)
+    {
+        // At least a quarter of ARRAY_STATS_PARALLEL_MIN per thread
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = size / (ARRAY_STATS_PARALLEL_MIN / 4);
+        if (threads > (size_t)cpus)
+            threads = cpus > 0 ? (size_t)cpus : 1;
+    }
+
+    if (threads < 2)
+    {
+        statsRange(arr, size, stats);
+    }
+    else
+    {
+        StatsTask tasks[64];
+        pthread_t ids[64];
+        size_t started = 0;
+        if (threads > 64)
+            threads = 64;
+
+        size_t per_thread = size / threads;
+        for (size_t t = 0; t < threads; t++)
+        {
+            tasks[t].arr = arr + t * per_thread;
+            tasks[t].n = t + 1 == threads ? size - t * per_thread : per_thread;
+        }
+        // Thread 0's share runs on the caller
+        for (size_t t = 1; t < threads; t++)
+        {
+            if (pthread_create(&ids[t], NULL, statsWorker, &tasks[t]) != 0)
+                break;
+            started++;
+        }
+        statsWorker(&tasks[0]);
+        for (size_t t = started + 1; t < threads; t++)
+            statsWorker(&tasks[t]);
+        for (size_t t = 1; t <= started; t++)
+            pthread_join(ids[t], NULL);
+
+        *stats = tasks[0].stats;
+        for (size_t t = 1; t < threads; t++)
+            mergeStats(stats, &tasks[t].stats, t * per_thread);
+    }
+
+    stats->count = size;
+    stats->mean = (double)stats->sum / (double)size;
+    return SUCCESS;
+}
+
+/**
+ * @brief Starts a set of streaming statistics
+ * @param stats Statistics to initialize
+ * @param quantiles Quantiles to estimate, each in (0, 1) (may be NULL)
+ * @param num_quantiles Number of quantiles, at most STREAM_STATS_MAX_QUANTILES
+ * @return 0 on success, error code on failure
+ */
+int streamStatsInit(StreamStats *stats, const double quantiles[], int num_quantiles)
+{
+    if (num_quantiles < 0 || num_quantiles > STREAM_STATS_MAX_QUANTILES ||
+        (num_quantiles > 0 && quantiles == NULL))
+        return ERROR_INVALID_INPUT;
+
+    memset(stats, 0, sizeof(*stats));
+    stats->min = INT64_MAX;
+    stats->max = INT64_MIN;
+    stats->num_quantiles = num_quantiles;
+    for (int q = 0; q < num_quantiles; q++)
+    {
+        P2Quantile *est = &stats->quantiles[q];
+        double p = quantiles[q];
+        if (p <= 0.0 || p >= 1.0)
+            return ERROR_INVALID_INPUT;
+
+        est->p = p;
+        for (int i = 0; i < 5; i++)
+            est->positions[i] = i + 1;
+        est->desired[0] = 1;
+        est->desired[1] = 1 + 2 * p;
+        est->desired[2] = 1 + 4 * p;
+        est->desired[3] = 3 + 2 * p;
+        est->desired[4] = 5;
+        est->increments[0] = 0;
+        est->increments[1] = p / 2;
+        est->increments[2] = p;
+        est->increments[3] = (1 + p) / 2;
+        est->increments[4] = 1;
+    }
+    return SUCCESS;
+}
+
+/**
+ * @brief Feeds one value to a P-squared estimator that has seen count values before
+ */
+static void p2Add(P2Quantile *est, uint64_t count, double x)
+{
+    double *q = est->heights;
+    double *n = est->positions;
+
+    // The first five values are kept sorted as the initial markers
+    if (count < 5)
+    {
+        int i = (int)count;
+        while (i > 0 && q[i - 1] > x)
+        {
+            q[i] = q[i - 1];
+            i--;
+        }
+        q[i] = x;
+        return;
+    }
+
+    int k;
+    if (x < q[0])
+    {
+        q[0] = x;
+        k = 0;
+    }
+    else if (x >= q[4])
+    {
+        q[4] = x;
+        k = 3;
+    }
+    else
+    {
+        k = 0;
+        while (x >= q[k + 1])
+            k++;
+    }
+
+    for (int i = k + 1; i < 5; i++)
+        n[i] += 1;
+    for (int i = 0; i < 5; i++)
+        est->desired[i] += est->increments[i];
+
+    // Move the three middle markers towards their desired positions
+    for (int i = 1; i <= 3; i++)
+    {
+        double d = est->desired[i] - n[i];
+        if ((d >= 1 && n[i + 1] - n[i] > 1) || (d <= -1 && n[i - 1] - n[i] < -1))
+        {
+            double s = d > 0 ? 1.0 : -1.0;
+            double parabolic = q[i] + s / (n[i + 1] - n[i - 1]) *
+                                          ((n[i] - n[i - 1] + s) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) +
+                                           (n[i + 1] - n[i] - s) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+            if (q[i - 1] < parabolic && parabolic < q[i + 1])
+                q[i] = parabolic;
+            else
+                q[i] += s * (q[i + (int)s] - q[i]) / (n[i + (int)s] - n[i]);
+            n[i] += s;
+        }
+    }
+}
+
+/**
+ * @brief Adds one value
+ * @param stats Statistics to update
+ * @param value Value to add
+ */
+void streamStatsAdd(StreamStats *stats, int64_t value)
+{
+    double x = (double)value;
+
+    for (int q = 0; q < stats->num_quantiles; q++)
+        p2Add(&stats->quantiles[q], stats->count, x);
+
+    stats->count++;
+    if (value < stats->min)
+        stats->min = value;
+    if (value > stats->max)
+        stats->max = value;
+
+    double delta = x - stats->mean;
+    stats->mean += delta / (double)stats->count;
+    stats->m2 += delta * (x - stats->mean);
+}
+
+/**
+ * @brief Adds a chunk of values
+ * @param stats Statistics to update
+ * @param arr Values to add
+ * @param size Number of values
+ */
+void streamStatsAddArray(StreamStats *stats, const int arr[], size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+        streamStatsAdd(stats, arr[i]);
+}
+
+/**
+ * @brief Returns the sample variance of the values seen so far
+ * @param stats Statistics to read
+ * @return Variance (0 with fewer than two values)
+ */
+double streamStatsVariance(const StreamStats *stats)
+{
+    return stats->count > 1 ? stats->m2 / (double)(stats->count - 1) : 0.0;
+}
+
+/**
+ * @brief Returns the current estimate of a quantile
+ * @param stats Statistics to read
+ * @param index Index into the quantiles given to streamStatsInit()
+ * @return Estimated quantile (exact while fewer than five values were seen)
+ */
+double streamStatsQuantile(const StreamStats *stats, int index)
+{
+    if (index < 0 || index >= stats->num_quantiles || stats->count == 0)
+        return 0.0;
+
+    const P2Quantile *est = &stats->quantiles[index];
+    if (stats->count < 5)
+    {
+        // Nearest rank among the sorted values kept so far
+        size_t rank = (size_t)ceil(est->p * (double)stats->count);
+        return est->heights[rank > 0 ? rank - 1 : 0];
+    }
+    return est->heights[2];
+}
+
+/**
+ * @brief Adds every value of a file of native-endian 32-bit integers
+ * @param path File to read
+ * @param stats Statistics to update
+ * @return 0 on success, error code on failure
+ */
+int streamStatsFromBinaryFile(const char *path, StreamStats *stats)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return ERROR_FILE_OPERATION;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return ERROR_FILE_OPERATION;
+    }
+
+    // Trailing bytes that do not make a whole value are ignored
+    size_t size = (size_t)st.st_size / sizeof(int32_t) * sizeof(int32_t);
+    if (size == 0)
+    {
+        close(fd);
+        return SUCCESS;
+    }
+
+    char *data = (char *)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return ERROR_FILE_OPERATION;
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    for (size_t offset = 0; offset < size; offset += STREAM_CHUNK_SIZE)
+    {
+        size_t length = size - offset < STREAM_CHUNK_SIZE ? size - offset : STREAM_CHUNK_SIZE;
+        const int32_t *values = (const int32_t *)(data + offset);
+        for (size_t i = 0; i < length / sizeof(int32_t); i++)
+            streamStatsAdd(stats, values[i]);
+
+        // Done with this chunk: let the kernel drop its pages
+        madvise(data + offset, length, MADV_DONTNEED);
+    }
+
+    munmap(data, size);
+    return SUCCESS;
+}
+
+/**
+ * @brief Two read buffers shared by the reader thread and the parser
+ */
+typedef struct
+{
+    int fd;
+    char *buffers[2];
+    ssize_t lengths[2];
+    int ready[2]; // filled by the reader, not yet consumed by the parser
+    int stop;     // set by the parser when it gives up early
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+} DoubleBuffer;
+
+static void *doubleBufferReader(void *arg)
+{
+    DoubleBuffer *db = (DoubleBuffer *)arg;
+
+    for (int b = 0;; b ^= 1)
+    {
+        pthread_mutex_lock(&db->lock);
+        while (db->ready[b] && !db->stop)
+            pthread_cond_wait(&db->changed, &db->lock);
+        int stop = db->stop;
+        pthread_mutex_unlock(&db->lock);
+        if (stop)
+            return NULL;
+
+        ssize_t length = read(db->fd, db->buffers[b], STREAM_READ_SIZE);
+
+        pthread_mutex_lock(&db->lock);
+        db->lengths[b] = length;
+        db->ready[b] = 1;
+        pthread_cond_broadcast(&db->changed);
+        pthread_mutex_unlock(&db->lock);
+
+        if (length <= 0)
+            return NULL;
+    }
 }
 
 /**
- * @brief Prints information message
- * @param message The message to print
+ * @brief Tells whether c separates numbers in a text file
  */
-void printInfo(const char *message)
+static int isNumberSeparator(char c)
 {
-    printf(BLUE "%s" RESET "\n", message);
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == ',';
 }
 
 /**
- * @brief Adds an entry to operation history
- * @param operation The operation description
+ * @brief Adds every integer of a text file
+ * @param path File to read
+ * @param stats Statistics to update
+ * @return 0 on success, error code on failure
  */
-void addToHistory(const char *operation)
+int streamStatsFromTextFile(const char *path, StreamStats *stats)
 {
-    if (g_historyCount < 100)
+    DoubleBuffer db;
+    pthread_t reader;
+    int result = SUCCESS;
+
+    db.fd = open(path, O_RDONLY);
+    if (db.fd < 0)
+        return ERROR_FILE_OPERATION;
+    posix_fadvise(db.fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    db.buffers[0] = (char *)safeAlloc(STREAM_READ_SIZE);
+    db.buffers[1] = (char *)safeAlloc(STREAM_READ_SIZE);
+    db.ready[0] = db.ready[1] = 0;
+    db.stop = 0;
+    pthread_mutex_init(&db.lock, NULL);
+    pthread_cond_init(&db.changed, NULL);
+
+    if (pthread_create(&reader, NULL, doubleBufferReader, &db) != 0)
     {
-        strncpy(g_history[g_historyCount].operation, operation, 99);
-        g_history[g_historyCount].operation[99] = '\0';
-        g_history[g_historyCount].timestamp = time(NULL);
-        g_historyCount++;
+        result = ERROR_MEMORY_ALLOCATION;
     }
     else
     {
-        printWarning("History buffer full. Oldest entry will be overwritten.");
+        // A number may straddle two buffers, so the parse state carries over
+        int in_number = 0, negative = 0, digits = 0;
+        int64_t value = 0;
 
-        // Shift all entries one position back
-        for (int i = 0; i < 99; i++)
+        for (int b = 0;; b ^= 1)
         {
-            g_history[i] = g_history[i + 1];
+            pthread_mutex_lock(&db.lock);
+            while (!db.ready[b])
+                pthread_cond_wait(&db.changed, &db.lock);
+            ssize_t length = db.lengths[b];
+            pthread_mutex_unlock(&db.lock);
+
+            if (length < 0)
+                result = ERROR_FILE_OPERATION;
+            if (length <= 0)
+                break;
+
+            // A token is an optional sign and digits; "1.5", "1e3" or "--" is an error
+            const char *text = db.buffers[b];
+            for (ssize_t i = 0; i < length && result == SUCCESS; i++)
+            {
+                unsigned digit = (unsigned)(text[i] - '0');
+                if (digit < 10)
+                {
+                    if (!in_number)
+                    {
+                        in_number = 1;
+                        negative = 0;
+                        value = 0;
+                    }
+                    if (value > (INT64_MAX - (int64_t)digit) / 10)
+                        result = ERROR_INVALID_INPUT;
+                    value = value * 10 + digit;
+                    digits = 1;
+                }
+                else if (isNumberSeparator(text[i]))
+                {
+                    if (in_number && !digits)
+                        result = ERROR_INVALID_INPUT;
+                    else if (in_number)
+                        streamStatsAdd(stats, negative ? -value : value);
+                    in_number = 0;
+                    digits = 0;
+                }
+                else if ((text[i] == '-' || text[i] == '+') && !in_number)
+                {
+                    in_number = 1;
+                    negative = text[i] == '-';
+                    value = 0;
+                }
+                else
+                {
+                    result = ERROR_INVALID_INPUT;
+                }
+            }
+
+            pthread_mutex_lock(&db.lock);
+            db.ready[b] = 0;
+            db.stop = result != SUCCESS;
+            pthread_cond_broadcast(&db.changed);
+            pthread_mutex_unlock(&db.lock);
+            if (result != SUCCESS)
+                break;
+        }
+        if (in_number && result == SUCCESS)
+        {
+            if (digits)
+                streamStatsAdd(stats, negative ? -value : value);
+            else
+                result = ERROR_INVALID_INPUT;
         }
 
-        // Add new entry at the end
-        strncpy(g_history[99].operation, operation, 99);
-        g_history[99].operation[99] = '\0';
-        g_history[99].timestamp = time(NULL);
+        pthread_join(reader, NULL);
     }
+
+    pthread_mutex_destroy(&db.lock);
+    pthread_cond_destroy(&db.changed);
+    free(db.buffers[0]);
+    free(db.buffers[1]);
+    close(db.fd);
+    return result;
 }
 
 /**
- * @brief Displays the operation history
+ * @brief Finds maximum in an array
+ * @param arr Array of integers
+ * @param size Size of array
+ * @return Maximum value
  */
-void displayHistory()
+int findMax(const int arr[], int size)
 {
-    printf(BOLD "\n===== Operation History =====" RESET "\n");
-
-    if (g_historyCount == 0)
-    {
-        printf("No operations recorded yet.\n");
-        return;
-    }
+    ArrayStats stats;
 
-    for (int i = 0; i < g_historyCount; i++)
-    {
-        char timeStr[26];
-        ctime_r(&g_history[i].timestamp, timeStr);
-        timeStr[24] = '\0'; // Remove newline
-        printf("%d. [%s] %s\n", i + 1, timeStr, g_history[i].operation);
-    }
+    if (size <= 0)
+        return 0;
+    arrayStats(arr, (size_t)size, &stats);
+    return stats.max;
 }
 
 /**
- * @brief Clears the console screen
+ * @brief Finds minimum in an array
+ * @param arr Array of integers
+ * @param size Size of array
+ * @return Minimum value
  */
-void clearScreen()
+int findMin(const int arr[], int size)
 {
-#ifdef _WIN32
-    system("cls");
-#else
-    system("clear");
-#endif
+    ArrayStats stats;
+
+    if (size <= 0)
+        return 0;
+    arrayStats(arr, (size_t)size, &stats);
+    return stats.min;
 }
 
 /**
- * @brief Shows a progress bar
- * @param current Current progress
- * @param total Total work to be done
- * @param width Width of the progress bar
+ * @brief Calculates average of an array
+ * @param arr Array of integers
+ * @param size Size of array
+ * @return Average value
  */
-void showProgress(int current, int total, int width)
+float calculateAverage(const int arr[], int size)
 {
-    float percent = (float)current / total;
-    int chars = (int)(width * percent);
+    ArrayStats stats;
 
-    printf("\r[");
-    for (int i = 0; i < width; i++)
-    {
-        if (i < chars)
-            printf("#");
-        else
-            printf(" ");
-    }
-    printf("] %.1f%%", percent * 100);
-    fflush(stdout);
+    if (size <= 0)
+        return 0.0f;
+    arrayStats(arr, (size_t)size, &stats);
+    return (float)stats.mean;
 }
 
+typedef int (*PalindromeKernel)(const char *str, size_t len);
+typedef void (*ReverseKernel)(char *str, size_t len);
+
 /**
- * @brief Measures execution time of a function
- * @param func Function pointer to measure
- * @return Execution time in seconds
+ * @brief ASCII lower case without branches or locale lookups
  */
-double measureExecutionTime(void (*func)(void))
+static inline unsigned char foldCase(unsigned char c)
 {
-    clock_t start, end;
-
-    start = clock();
-    func();
-    end = clock();
-
-    return ((double)(end - start)) / CLOCKS_PER_SEC;
+    return (unsigned char)(c | ((unsigned char)(c - 'A') < 26 ? 0x20 : 0));
 }
 
 /**
- * @brief Saves result to a file
- * @param filename File to save to
- * @param format Format string
- * @param ... Additional arguments for format
- * @return 0 on success, error code on failure
+ * @brief Compares str[i..j] against itself reversed, byte by byte
  */
-int saveToFile(const char *filename, const char *format, ...)
+static int palindromeTail(const char *str, size_t i, size_t j)
 {
-    FILE *fp = fopen(filename, "w");
-    if (fp == NULL)
+    for (; i < j; i++, j--)
     {
-        printError(ERROR_FILE_OPERATION);
-        return ERROR_FILE_OPERATION;
+        if (foldCase((unsigned char)str[i]) != foldCase((unsigned char)str[j]))
+            return 0;
     }
+    return 1;
+}
 
-    va_list args;
-    va_start(args, format);
-    vfprintf(fp, format, args);
-    va_end(args);
-
-    fclose(fp);
+static void reverseTail(char *str, size_t i, size_t j)
+{
+    for (; i < j; i++, j--)
+    {
+        char temp = str[i];
+        str[i] = str[j];
+        str[j] = temp;
+    }
+}
 
-    char message[100];
-    sprintf(message, "Result saved to %s", filename);
-    printSuccess(message);
+static int palindromeScalar(const char *str, size_t len)
+{
+    return len < 2 || palindromeTail(str, 0, len - 1);
+}
 
-    return SUCCESS;
+static void reverseScalar(char *str, size_t len)
+{
+    if (len > 1)
+        reverseTail(str, 0, len - 1);
 }
 
-/**
- * @brief Loads data from a file
- * @param filename File to load from
- * @param buffer Buffer to store data
- * @param size Size of buffer
- * @return 0 on success, error code on failure
+#ifdef HAVE_X86_KERNELS
+/*
+ * The SIMD versions take a block from each end, reverse the back block in
+ * registers and then compare (or swap) the two. Blocks stop before they
+ * would overlap and the middle is finished byte by byte.
  */
-int loadFromFile(const char *filename, char *buffer, size_t size)
+__attribute__((target("sse2"))) static inline __m128i reverseBytesSse2(__m128i v)
 {
-    FILE *fp = fopen(filename, "r");
-    if (fp == NULL)
-    {
-        printError(ERROR_FILE_OPERATION);
-        return ERROR_FILE_OPERATION;
-    }
-
-    size_t read_size = fread(buffer, 1, size - 1, fp);
-    buffer[read_size] = '\0';
+    // Reverse dwords, then words within dwords, then bytes within words
+    v = _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
 
-    fclose(fp);
+__attribute__((target("sse2"))) static inline __m128i foldCaseSse2(__m128i v)
+{
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)),
+                                  _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), v));
+    return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
 
-    char message[100];
-    sprintf(message, "Data loaded from %s", filename);
-    printSuccess(message);
+__attribute__((target("sse2"))) static int palindromeSse2(const char *str, size_t len)
+{
+    size_t i = 0;
 
-    return SUCCESS;
+    for (; 2 * (i + 16) <= len; i += 16)
+    {
+        __m128i front = foldCaseSse2(_mm_loadu_si128((const __m128i *)(str + i)));
+        __m128i back = foldCaseSse2(_mm_loadu_si128((const __m128i *)(str + len - i - 16)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(front, reverseBytesSse2(back))) != 0xFFFF)
+            return 0;
+    }
+    return len - i < 2 || palindromeTail(str, i, len - i - 1);
 }
 
-/**
- * @brief Displays a menu and gets user choice
- * @param title Menu title
- * @param options Array of option strings
- * @param num_options Number of options
- * @return User's choice (1-based index)
- */
-int displayMenu(const char *title, const char *options[], int num_options)
+__attribute__((target("sse2"))) static void reverseSse2(char *str, size_t len)
 {
-    printf(BOLD "\n===== %s =====" RESET "\n", title);
+    size_t i = 0;
 
-    for (int i = 0; i < num_options; i++)
+    for (; 2 * (i + 16) <= len; i += 16)
     {
-        printf("%d. %s\n", i + 1, options[i]);
+        __m128i front = _mm_loadu_si128((const __m128i *)(str + i));
+        __m128i back = _mm_loadu_si128((const __m128i *)(str + len - i - 16));
+        _mm_storeu_si128((__m128i *)(str + i), reverseBytesSse2(back));
+        _mm_storeu_si128((__m128i *)(str + len - i - 16), reverseBytesSse2(front));
     }
-    printf("0. Exit\n");
+    if (len - i > 1)
+        reverseTail(str, i, len - i - 1);
+}
 
-    return validateInteger("Enter your choice: ", 0, num_options);
+__attribute__((target("avx2"))) static inline __m256i reverseBytesAvx2(__m256i v)
+{
+    // Reverse within each 128-bit lane, then swap the lanes
+    const __m256i mask = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                          15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, mask), _MM_SHUFFLE(1, 0, 3, 2));
 }
 
-/**
- * @brief Gets current date and time as a string
- * @param buffer Buffer to store the date string
- * @param size Size of buffer
- */
-void getCurrentDateTime(char *buffer, size_t size)
+__attribute__((target("avx2"))) static inline __m256i foldCaseAvx2(__m256i v)
 {
-    time_t now = time(NULL);
-    strftime(buffer, size, "%Y-%m-%d %H:%M:%S", localtime(&now));
+    __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('A' - 1)),
+                                     _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), v));
+    return _mm256_or_si256(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
 }
 
-/**
- * @brief Generates a random integer in a range
- * @param min Minimum value (inclusive)
- * @param max Maximum value (inclusive)
- * @return Random integer
- */
-int getRandomInt(int min, int max)
+__attribute__((target("avx2"))) static int palindromeAvx2(const char *str, size_t len)
 {
-    static int seeded = 0;
+    size_t i = 0;
 
-    if (!seeded)
+    for (; 2 * (i + 32) <= len; i += 32)
     {
-        srand(time(NULL));
-        seeded = 1;
+        __m256i front = foldCaseAvx2(_mm256_loadu_si256((const __m256i *)(str + i)));
+        __m256i back = foldCaseAvx2(_mm256_loadu_si256((const __m256i *)(str + len - i - 32)));
+        if ((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(front, reverseBytesAvx2(back))) != 0xFFFFFFFFu)
+            return 0;
     }
-
-    return min + rand() % (max - min + 1);
+    return palindromeSse2(str + i, len - 2 * i);
 }
 
-/**
- * @brief Swaps two integers
- * @param a Pointer to first integer
- * @param b Pointer to second integer
- */
-void swapInt(int *a, int *b)
+__attribute__((target("avx2"))) static void reverseAvx2(char *str, size_t len)
 {
-    int temp = *a;
-    *a = *b;
-    *b = temp;
+    size_t i = 0;
+
+    for (; 2 * (i + 32) <= len; i += 32)
+    {
+        __m256i front = _mm256_loadu_si256((const __m256i *)(str + i));
+        __m256i back = _mm256_loadu_si256((const __m256i *)(str + len - i - 32));
+        _mm256_storeu_si256((__m256i *)(str + i), reverseBytesAvx2(back));
+        _mm256_storeu_si256((__m256i *)(str + len - i - 32), reverseBytesAvx2(front));
+    }
+    reverseSse2(str + i, len - 2 * i);
 }
+#endif
+
+static PalindromeKernel g_palindromeKernel = NULL;
+static ReverseKernel g_reverseKernel = NULL;
 
 /**
- * @brief Finds maximum in an array
- * @param arr Array of integers
- * @param size Size of array
- * @return Maximum value
+ * @brief Picks the kernels used by the palindrome and reverse functions
+ * @param name "scalar", "sse2" or "avx2", or NULL for the widest the CPU supports
+ * @return Name of the kernels in use
  */
-int findMax(const int arr[], int size)
+const char *selectStringKernel(const char *name)
 {
-    if (size <= 0)
-        return 0;
+#ifdef HAVE_X86_KERNELS
+    __builtin_cpu_init();
+    int avx2 = __builtin_cpu_supports("avx2");
+    int sse2 = __builtin_cpu_supports("sse2");
 
-    int max = arr[0];
-    for (int i = 1; i < size; i++)
+    if (name != NULL && strcmp(name, "scalar") == 0)
+        avx2 = sse2 = 0;
+    else if (name != NULL && strcmp(name, "sse2") == 0)
+        avx2 = 0;
+
+    if (avx2)
     {
-        if (arr[i] > max)
-        {
-            max = arr[i];
-        }
+        g_palindromeKernel = palindromeAvx2;
+        g_reverseKernel = reverseAvx2;
+        return "avx2";
+    }
+    if (sse2)
+    {
+        g_palindromeKernel = palindromeSse2;
+        g_reverseKernel = reverseSse2;
+        return "sse2";
     }
-    return max;
+#else
+    (void)name;
+#endif
+    g_palindromeKernel = palindromeScalar;
+    g_reverseKernel = reverseScalar;
+    return "scalar";
+}
+
+static pthread_once_t g_stringKernelOnce = PTHREAD_ONCE_INIT;
+
+static void selectDefaultStringKernel()
+{
+    if (g_palindromeKernel == NULL)
+        selectStringKernel(NULL);
 }
 
 /**
- * @brief Finds minimum in an array
- * @param arr Array of integers
- * @param size Size of array
- * @return Minimum value
+ * @brief Checks if a buffer reads the same backwards, ignoring ASCII case
+ * @param str Buffer to check
+ * @param len Number of bytes
+ * @return 1 if palindrome, 0 otherwise
  */
-int findMin(const int arr[], int size)
+int isPalindromeN(const char *str, size_t len)
 {
-    if (size <= 0)
-        return 0;
-
-    int min = arr[0];
-    for (int i = 1; i < size; i++)
-    {
-        if (arr[i] < min)
-        {
-            min = arr[i];
-        }
-    }
-    return min;
+    pthread_once(&g_stringKernelOnce, selectDefaultStringKernel);
+    return g_palindromeKernel(str, len);
 }
 
 /**
- * @brief Calculates average of an array
- * @param arr Array of integers
- * @param size Size of array
- * @return Average value
+ * @brief Reverses a buffer in place
+ * @param str Buffer to reverse
+ * @param len Number of bytes
  */
-float calculateAverage(const int arr[], int size)
+void reverseStringN(char *str, size_t len)
 {
-    if (size <= 0)
-        return 0.0f;
-
-    int sum = 0;
-    for (int i = 0; i < size; i++)
-    {
-        sum += arr[i];
-    }
-    return (float)sum / size;
+    pthread_once(&g_stringKernelOnce, selectDefaultStringKernel);
+    g_reverseKernel(str, len);
 }
 
 /**
@@ -497,15 +2539,7 @@ float calculateAverage(const int arr[], int size)
  */
 int isPalindrome(const char *str)
 {
-    int len = strlen(str);
-    for (int i = 0; i < len / 2; i++)
-    {
-        if (tolower(str[i]) != tolower(str[len - i - 1]))
-        {
-            return 0;
-        }
-    }
-    return 1;
+    return isPalindromeN(str, strlen(str));
 }
 
 /**
@@ -514,13 +2548,7 @@ int isPalindrome(const char *str)
  */
 void reverseString(char *str)
 {
-    int len = strlen(str);
-    for (int i = 0; i < len / 2; i++)
-    {
-        char temp = str[i];
-        str[i] = str[len - i - 1];
-        str[len - i - 1] = temp;
-    }
+    reverseStringN(str, strlen(str));
 }
 
 /**
@@ -530,26 +2558,47 @@ void reverseString(char *str)
  * @param highlight Index to highlight (or -1 for none)
  */
 void visualizeArray(const int arr[], int size, int highlight)
+{
+    static FrameBuffer frame;
+    static int initialized = 0;
+
+    if (!initialized)
+    {
+        frameBufferInit(&frame, STDOUT_FILENO, 0, 4096);
+        initialized = 1;
+    }
+
+    frameBufferBegin(&frame);
+    visualizeArrayFrame(&frame, arr, size, highlight);
+    frameBufferEmit(&frame, 1);
+}
+
+/**
+ * @brief Draws an array as a bar chart into a frame without sending it
+ * @param frame Frame buffer to append to
+ * @param arr Array to visualize
+ * @param size Size of array
+ * @param highlight Index to highlight (or -1 for none)
+ */
+void visualizeArrayFrame(FrameBuffer *frame, const int arr[], int size, int highlight)
 {
     int max = findMax(arr, size);
     int scale = (max > 50) ? max / 50 + 1 : 1;
 
-    printf("\n");
+    frameBufferAppend(frame, "\n", 1);
     for (int i = 0; i < size; i++)
     {
         if (i == highlight)
-            printf(RED);
-        printf("%3d |", arr[i]);
+            frameBufferAppend(frame, RED, sizeof(RED) - 1);
+        frameBufferPrintf(frame, "%3d |", arr[i]);
 
         int bars = arr[i] / scale;
-        for (int j = 0; j < bars; j++)
-        {
-            printf("█");
-        }
+        if (bars > 0)
+            frameBufferAppendRepeat(frame, "█", sizeof("█") - 1, bars);
 
         if (i == highlight)
-            printf(RESET);
-        printf("\n");
+            frameBufferAppend(frame, RESET, sizeof(RESET) - 1);
+        frameBufferAppend(frame, "\n", 1);
     }
 }
 
@@ -566,8 +2615,12 @@ void showHelp(const char *program_name, const char *description, const char *usa
     printf("Usage: %s\n", usage);
 }
 
+#ifndef PREMIUM_UTILS_NO_MAIN
 /**
  * @brief Main function for testing the utilities
+ *
+ * Define PREMIUM_UTILS_NO_MAIN when linking premium_utils.c into another
+ * program.
  */
 int main()
 {
@@ -674,4 +2727,5 @@ int main()
 
     printInfo("Thank you for testing Premium Utilities!");
     return 0;
-}
\ No newline at end of file
+}
+#endif /* PREMIUM_UTILS_NO_MAIN */
\ No newline at end of file
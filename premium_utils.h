@@ -12,6 +12,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
 #include <time.h>
 
 /**
@@ -51,6 +54,11 @@
     do { if (DEBUG) fprintf(stderr, "%s:%d:%s(): " fmt, __FILE__, \
                             __LINE__, __func__, __VA_ARGS__); } while (0)
 
+/**
+ * @brief Number of history entries kept unless setHistoryCapacity() is called
+ */
+#define HISTORY_DEFAULT_CAPACITY 128
+
 /**
  * @brief Type for history entry
  */
@@ -59,6 +67,240 @@ typedef struct {
     time_t timestamp;
 } HistoryEntry;
 
+/**
+ * @brief Hardware performance counter flag
+ *
+ * With PERF_COUNTERS set to 1, PERF_REGION_BEGIN(name) / PERF_REGION_END(name)
+ * count cycles, instructions, cache misses and branch misses between them
+ * (including threads started inside the region) and print the totals to
+ * stderr. With the default of 0 both macros expand to nothing.
+ */
+#ifndef PERF_COUNTERS
+#define PERF_COUNTERS 0
+#endif
+
+#if PERF_COUNTERS
+#define PERF_REGION_BEGIN(name) \
+    PerfRegion perf_region_##name; \
+    perfRegionStart(&perf_region_##name, #name)
+#define PERF_REGION_END(name) \
+    do { perfRegionStop(&perf_region_##name); \
+         printPerfRegion(stderr, &perf_region_##name); } while (0)
+#else
+#define PERF_REGION_BEGIN(name)
+#define PERF_REGION_END(name)
+#endif
+
+/**
+ * @brief Hardware events counted in a region
+ */
+typedef enum {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_CACHE_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_EVENT_COUNT
+} PerfEvent;
+
+/**
+ * @brief Type for a region measured with hardware counters
+ */
+typedef struct {
+    const char *name;
+    int fds[PERF_EVENT_COUNT];         /* -1 where the event is unavailable */
+    uint64_t values[PERF_EVENT_COUNT]; /* scaled for multiplexing */
+    uint64_t start_ns;
+    uint64_t elapsed_ns;
+} PerfRegion;
+
+/**
+ * @brief Arrays at least this long are split across threads by arrayStats()
+ */
+#define ARRAY_STATS_PARALLEL_MIN (1 << 20)
+
+/**
+ * @brief Type for the statistics of an integer array
+ */
+typedef struct {
+    int min;
+    int max;
+    int64_t sum;
+    double mean;
+    size_t argmin;  /* index of the first minimum */
+    size_t argmax;  /* index of the first maximum */
+    size_t count;
+} ArrayStats;
+
+/**
+ * @brief Streaming statistics limits and buffer sizes
+ */
+#define STREAM_STATS_MAX_QUANTILES 8
+#define STREAM_CHUNK_SIZE (16 << 20) /* bytes of a mapped file processed at a time */
+#define STREAM_READ_SIZE (1 << 20)   /* bytes per text read buffer (two are used) */
+
+/**
+ * @brief Type for a P-squared quantile estimator
+ *
+ * Tracks one quantile with five markers whose heights are adjusted by
+ * piecewise-parabolic interpolation as values arrive (Jain & Chlamtac), so
+ * memory stays constant however many values are seen.
+ */
+typedef struct {
+    double p;
+    double heights[5];
+    double positions[5];
+    double desired[5];
+    double increments[5];
+} P2Quantile;
+
+/**
+ * @brief Type for one-pass statistics over a stream of integers
+ */
+typedef struct {
+    uint64_t count;
+    int64_t min;
+    int64_t max;
+    double mean;
+    double m2;  /* sum of squared deviations from the mean (Welford) */
+    int num_quantiles;
+    P2Quantile quantiles[STREAM_STATS_MAX_QUANTILES];
+} StreamStats;
+
+/**
+ * @brief Highest rate at which rate-limited frames reach the terminal
+ */
+#define FRAME_RATE_HZ 60
+
+/**
+ * @brief Type for a terminal frame built in memory and written at once
+ *
+ * A frame is assembled with the frameBuffer*() append functions and sent
+ * with frameBufferEmit() in a single write(). An in-place frame redraws
+ * over the previous one and only sends the lines (and the part of each
+ * line) that changed.
+ */
+typedef struct {
+    int fd;
+    int in_place;       /* redraw over the previous frame instead of below it */
+    char *data;         /* frame being built */
+    size_t length;
+    size_t capacity;
+    char *previous;     /* last frame sent, for in-place diffs */
+    size_t previous_length;
+    size_t previous_capacity;
+    int has_previous;
+    char *output;       /* bytes actually written */
+    size_t output_length;
+    size_t output_capacity;
+    uint64_t last_emit_ns;
+} FrameBuffer;
+
+/**
+ * @brief Default time between progress reports, in milliseconds
+ */
+#define PROGRESS_DEFAULT_INTERVAL_MS 250
+
+/**
+ * @brief Type for a progress reporter shared by worker threads
+ *
+ * Workers add finished work to `done` with progressAdd() (one relaxed
+ * atomic add, ideally per batch). A background thread samples the counter
+ * every interval and draws throughput and ETA on stderr. Code that only
+ * takes a plain counter can be given &reporter.done.
+ */
+typedef struct {
+    atomic_uint_fast64_t done;
+    uint64_t total;          /* 0 if unknown: no percentage or ETA */
+    const char *label;
+    const char *unit;        /* e.g. "guesses" */
+    uint64_t interval_ns;
+    uint64_t start_ns;
+    uint64_t last_ns;
+    uint64_t last_done;
+    double rate;             /* smoothed units per second */
+    int running;
+    int stopping;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    FrameBuffer frame;
+} ProgressReporter;
+
+/**
+ * @brief History log file layout and buffering
+ */
+#define HISTORY_LOG_MAGIC "PHL1"
+#define HISTORY_LOG_BATCH 4096   /* records written (and fsync'd) together */
+#define HISTORY_LOG_PAGE_SIZE 20 /* records shown per page */
+
+/**
+ * @brief Type for a history record as stored in the log file
+ */
+typedef struct {
+    int64_t timestamp;
+    char operation[120];
+} HistoryRecord;
+
+/**
+ * @brief Type for a history log mapped for reading
+ */
+typedef struct {
+    const HistoryRecord *records;
+    size_t count;
+    void *map;
+    size_t map_size;
+} HistoryLog;
+
+/**
+ * @brief Benchmark defaults
+ */
+#define BENCH_DEFAULT_SAMPLES 31
+#define BENCH_WARMUP_NS 20000000ULL   /* time spent warming up before calibrating */
+#define BENCH_SAMPLE_NS 2000000ULL    /* target duration of one sample */
+
+/**
+ * @brief Keeps the compiler from discarding a value or caching memory
+ *
+ * Use DO_NOT_OPTIMIZE on results a benchmarked function computes and
+ * CLOBBER_MEMORY after stores that are never read back.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define DO_NOT_OPTIMIZE(value) __asm__ volatile("" : : "r,m"(value) : "memory")
+#define CLOBBER_MEMORY() __asm__ volatile("" : : : "memory")
+#else
+#define DO_NOT_OPTIMIZE(value) benchmarkSink((const void *)&(value))
+#define CLOBBER_MEMORY() benchmarkSink(NULL)
+#endif
+
+/**
+ * @brief Output formats for benchmark results
+ */
+typedef enum {
+    BENCH_FORMAT_TEXT,
+    BENCH_FORMAT_CSV,
+    BENCH_FORMAT_JSON
+} BenchFormat;
+
+/**
+ * @brief Type for a function being benchmarked
+ */
+typedef void (*BenchFunction)(void *ctx);
+
+/**
+ * @brief Type for the timings of one benchmark, in nanoseconds per call
+ */
+typedef struct {
+    char name[64];
+    uint64_t iterations;  /* calls per sample */
+    int samples;
+    double min_ns;
+    double median_ns;
+    double p99_ns;
+    double mean_ns;
+    double stddev_ns;
+    double bytes_per_call;  /* set by the caller for throughput, 0 if not applicable */
+} BenchResult;
+
 /**
  * @brief Validates an integer input
  * @param prompt The prompt to display
@@ -108,17 +350,91 @@ void printWarning(const char *message);
  */
 void printInfo(const char *message);
 
+/**
+ * @brief Sets how many entries the history keeps, discarding current entries
+ *
+ * Must not be called while other threads are adding entries.
+ * @param capacity Number of entries, rounded up to a power of two
+ * @return 0 on success, error code on failure
+ */
+int setHistoryCapacity(size_t capacity);
+
+/**
+ * @brief Returns how many entries the history currently holds
+ * @return Number of entries, at most the capacity
+ */
+size_t getHistoryCount();
+
 /**
  * @brief Adds an entry to operation history
+ *
+ * Safe to call from many threads at once. When the history is full the
+ * oldest entry is overwritten in O(1).
  * @param operation The operation description
  */
 void addToHistory(const char *operation);
 
 /**
- * @brief Displays the operation history
+ * @brief Displays the operation history, oldest entry first
+ *
+ * With a log open (see openHistoryLog()) the whole log is paged through
+ * instead of the in-memory entries.
  */
 void displayHistory();
 
+/**
+ * @brief Starts appending every new history entry to a log file
+ *
+ * The file is created if needed. Records are buffered and written with one
+ * write() and one fsync() per HISTORY_LOG_BATCH records.
+ * @param path Log file path
+ * @return 0 on success, error code on failure
+ */
+int openHistoryLog(const char *path);
+
+/**
+ * @brief Writes and syncs any buffered log records
+ * @return 0 on success, error code on failure
+ */
+int flushHistoryLog();
+
+/**
+ * @brief Flushes and closes the history log
+ */
+void closeHistoryLog();
+
+/**
+ * @brief Maps a history log file for reading
+ * @param log Log to fill in
+ * @param path Log file path
+ * @return 0 on success, error code on failure
+ */
+int mapHistoryLog(HistoryLog *log, const char *path);
+
+/**
+ * @brief Unmaps a history log
+ * @param log Log to release
+ */
+void unmapHistoryLog(HistoryLog *log);
+
+/**
+ * @brief Finds the first record at or after a time by binary search
+ * @param log Mapped log
+ * @param when Time to search for
+ * @return Index of the first record with timestamp >= when (count if none)
+ */
+size_t findHistoryRecord(const HistoryLog *log, time_t when);
+
+/**
+ * @brief Displays the log records in [from, to), one page at a time
+ * @param path Log file path
+ * @param from First time to show
+ * @param to Time to stop at
+ * @param page_size Records per page (0 shows everything without pausing)
+ * @return 0 on success, error code on failure
+ */
+int displayHistoryLog(const char *path, time_t from, time_t to, size_t page_size);
+
 /**
  * @brief Clears the console screen
  */
@@ -126,6 +442,9 @@ void clearScreen();
 
 /**
  * @brief Shows a progress bar
+ *
+ * Redraws only what changed, at most FRAME_RATE_HZ times a second; the
+ * final update (current >= total) is always drawn.
  * @param current Current progress
  * @param total Total work to be done
  * @param width Width of the progress bar
@@ -133,12 +452,184 @@ void clearScreen();
 void showProgress(int current, int total, int width);
 
 /**
- * @brief Measures execution time of a function
+ * @brief Initializes a frame buffer
+ * @param frame Frame buffer to initialize
+ * @param fd Descriptor frames are written to
+ * @param in_place 1 to redraw each frame over the previous one
+ * @param capacity Initial buffer size in bytes (grows if needed)
+ */
+void frameBufferInit(FrameBuffer *frame, int fd, int in_place, size_t capacity);
+
+/**
+ * @brief Starts a new frame, discarding anything appended since the last emit
+ * @param frame Frame buffer to reset
+ */
+void frameBufferBegin(FrameBuffer *frame);
+
+/**
+ * @brief Appends bytes to the frame
+ * @param frame Frame buffer to append to
+ * @param data Bytes to append
+ * @param length Number of bytes
+ */
+void frameBufferAppend(FrameBuffer *frame, const char *data, size_t length);
+
+/**
+ * @brief Appends a cell (e.g. "#" or a multi-byte block character) count times
+ * @param frame Frame buffer to append to
+ * @param cell Bytes of one cell
+ * @param cell_length Number of bytes per cell
+ * @param count Number of cells
+ */
+void frameBufferAppendRepeat(FrameBuffer *frame, const char *cell, size_t cell_length, size_t count);
+
+/**
+ * @brief Appends formatted text to the frame
+ * @param frame Frame buffer to append to
+ * @param format Format string
+ * @param ... Additional arguments for format
+ */
+void frameBufferPrintf(FrameBuffer *frame, const char *format, ...);
+
+/**
+ * @brief Sends the frame with one write()
+ * @param frame Frame buffer to send
+ * @param force 0 to skip the frame if the last one went out less than 1/FRAME_RATE_HZ ago
+ * @return 1 if the frame was written, 0 if it was skipped or unchanged
+ */
+int frameBufferEmit(FrameBuffer *frame, int force);
+
+/**
+ * @brief Tells whether a rate-limited emit would be skipped right now
+ * @param frame Frame buffer to check
+ * @return 1 if the frame would be dropped, so building it can be skipped
+ */
+int frameBufferThrottled(const FrameBuffer *frame);
+
+/**
+ * @brief Releases a frame buffer
+ * @param frame Frame buffer to free
+ */
+void frameBufferFree(FrameBuffer *frame);
+
+/**
+ * @brief Initializes a progress reporter
+ * @param progress Reporter to initialize
+ * @param label Text shown before the bar
+ * @param unit Name of the units counted (e.g. "guesses")
+ * @param total Expected number of units, or 0 if unknown
+ * @param interval_ms Time between reports (0 for PROGRESS_DEFAULT_INTERVAL_MS)
+ */
+void progressInit(ProgressReporter *progress, const char *label, const char *unit,
+                  uint64_t total, int interval_ms);
+
+/**
+ * @brief Starts the background reporter thread
+ * @param progress Reporter to start
+ * @return SUCCESS or ERROR_INVALID_INPUT if the thread could not be created
+ */
+int progressStart(ProgressReporter *progress);
+
+/**
+ * @brief Records finished work; safe to call from any thread
+ * @param progress Reporter to update
+ * @param count Units finished since the last call
+ */
+static inline void progressAdd(ProgressReporter *progress, uint64_t count)
+{
+    atomic_fetch_add_explicit(&progress->done, count, memory_order_relaxed);
+}
+
+/**
+ * @brief Stops the reporter thread and prints the final totals
+ * @param progress Reporter to stop
+ */
+void progressStop(ProgressReporter *progress);
+
+/**
+ * @brief Draws an array as a bar chart into a frame without sending it
+ * @param frame Frame buffer to append to
+ * @param arr Array to visualize
+ * @param size Size of array
+ * @param highlight Index to highlight (or -1 for none)
+ */
+void visualizeArrayFrame(FrameBuffer *frame, const int arr[], int size, int highlight);
+
+/**
+ * @brief Measures execution time of a single call to a function
  * @param func Function pointer to measure
- * @return Execution time in seconds
+ * @return Wall-clock execution time in seconds
  */
 double measureExecutionTime(void (*func)(void));
 
+/**
+ * @brief Reads the monotonic clock
+ * @return Nanoseconds since an arbitrary fixed point
+ */
+uint64_t monotonicNanos();
+
+/**
+ * @brief Benchmarks a function
+ *
+ * The function is run for BENCH_WARMUP_NS, then the number of calls per
+ * sample is doubled until a sample takes at least BENCH_SAMPLE_NS, and then
+ * the given number of samples is timed.
+ * @param name Name stored in the result
+ * @param func Function to run
+ * @param ctx Argument passed to every call
+ * @param samples Number of samples (0 for BENCH_DEFAULT_SAMPLES)
+ * @param result Receives the per-call timings
+ * @return 0 on success, error code on failure
+ */
+int runBenchmark(const char *name, BenchFunction func, void *ctx, int samples, BenchResult *result);
+
+/**
+ * @brief Prints benchmark results as a table, CSV or a JSON array
+ *
+ * Results with bytes_per_call set also get a GB/s figure (from the median).
+ * @param fp Stream to print to
+ * @param results Results to print
+ * @param count Number of results
+ * @param format Output format
+ */
+void printBenchmarkResults(FILE *fp, const BenchResult results[], int count, BenchFormat format);
+
+/**
+ * @brief Opens and starts the counters of a region
+ *
+ * Events the kernel or CPU does not allow are left out; the region still
+ * measures wall time.
+ * @param region Region to start
+ * @param name Name printed with the results
+ * @return 0 if at least one counter is running, error code otherwise
+ */
+int perfRegionStart(PerfRegion *region, const char *name);
+
+/**
+ * @brief Updates the values and elapsed time of a running region
+ * @param region Region to read
+ */
+void perfRegionRead(PerfRegion *region);
+
+/**
+ * @brief Reads the final values of a region and closes its counters
+ * @param region Region to stop
+ */
+void perfRegionStop(PerfRegion *region);
+
+/**
+ * @brief Prints the values of a region on one line
+ * @param fp Stream to print to
+ * @param region Region to print
+ */
+void printPerfRegion(FILE *fp, const PerfRegion *region);
+
+/**
+ * @brief Reads a value through a volatile pointer (for DO_NOT_OPTIMIZE without GCC)
+ * @param value Value to read, or NULL
+ */
+void benchmarkSink(const void *value);
+
 /**
  * @brief Saves result to a file
  * @param filename File to save to
@@ -188,6 +679,88 @@ int getRandomInt(int min, int max);
  */
 void swapInt(int *a, int *b);
 
+/**
+ * @brief Computes min, max, sum, mean and their positions in one pass
+ *
+ * Uses AVX2 or SSE2 when the CPU has them, and several threads for arrays
+ * of ARRAY_STATS_PARALLEL_MIN elements or more.
+ * @param arr Array of integers
+ * @param size Size of array
+ * @param stats Receives the statistics
+ * @return 0 on success, error code on failure
+ */
+int arrayStats(const int arr[], size_t size, ArrayStats *stats);
+
+/**
+ * @brief Picks the kernel used by arrayStats() (for benchmarking)
+ * @param name "scalar", "sse2" or "avx2", or NULL for the widest the CPU supports
+ * @return Name of the kernel in use
+ */
+const char *selectArrayStatsKernel(const char *name);
+
+/**
+ * @brief Starts a set of streaming statistics
+ * @param stats Statistics to initialize
+ * @param quantiles Quantiles to estimate, each in (0, 1) (may be NULL)
+ * @param num_quantiles Number of quantiles, at most STREAM_STATS_MAX_QUANTILES
+ * @return 0 on success, error code on failure
+ */
+int streamStatsInit(StreamStats *stats, const double quantiles[], int num_quantiles);
+
+/**
+ * @brief Adds one value
+ * @param stats Statistics to update
+ * @param value Value to add
+ */
+void streamStatsAdd(StreamStats *stats, int64_t value);
+
+/**
+ * @brief Adds a chunk of values
+ * @param stats Statistics to update
+ * @param arr Values to add
+ * @param size Number of values
+ */
+void streamStatsAddArray(StreamStats *stats, const int arr[], size_t size);
+
+/**
+ * @brief Returns the sample variance of the values seen so far
+ * @param stats Statistics to read
+ * @return Variance (0 with fewer than two values)
+ */
+double streamStatsVariance(const StreamStats *stats);
+
+/**
+ * @brief Returns the current estimate of a quantile
+ * @param stats Statistics to read
+ * @param index Index into the quantiles given to streamStatsInit()
+ * @return Estimated quantile (exact while fewer than five values were seen)
+ */
+double streamStatsQuantile(const StreamStats *stats, int index);
+
+/**
+ * @brief Adds every value of a file of native-endian 32-bit integers
+ *
+ * The file is mapped and processed STREAM_CHUNK_SIZE bytes at a time, with
+ * each chunk released after use, so memory use does not grow with the file.
+ * @param path File to read
+ * @param stats Statistics to update
+ * @return 0 on success, error code on failure
+ */
+int streamStatsFromBinaryFile(const char *path, StreamStats *stats);
+
+/**
+ * @brief Adds every integer of a text file
+ *
+ * Numbers are decimal integers with an optional sign, separated by
+ * whitespace or commas. Anything else ("1.5", "1e3", "12abc") stops the
+ * read with ERROR_INVALID_INPUT, keeping the values added before it.
+ * A reader thread fills one of two buffers while the other is parsed.
+ * @param path File to read
+ * @param stats Statistics to update
+ * @return 0 on success, error code on failure
+ */
+int streamStatsFromTextFile(const char *path, StreamStats *stats);
+
 /**
  * @brief Finds maximum in an array
  * @param arr Array of integers
@@ -205,7 +778,7 @@ int findMax(const int arr[], int size);
 int findMin(const int arr[], int size);
 
 /**
- * @brief Calculates average of an array
+ * @brief Calculates average of an array (summed in 64 bits)
  * @param arr Array of integers
  * @param size Size of array
  * @return Average value
@@ -225,6 +798,30 @@ int isPalindrome(const char *str);
  */
 void reverseString(char *str);
 
+/**
+ * @brief Checks if a buffer reads the same backwards, ignoring ASCII case
+ *
+ * Compares 32 (AVX2) or 16 (SSE2) bytes from each end at a time.
+ * @param str Buffer to check
+ * @param len Number of bytes
+ * @return 1 if palindrome, 0 otherwise
+ */
+int isPalindromeN(const char *str, size_t len);
+
+/**
+ * @brief Reverses a buffer in place, 32 (AVX2) or 16 (SSE2) bytes from each end at a time
+ * @param str Buffer to reverse
+ * @param len Number of bytes
+ */
+void reverseStringN(char *str, size_t len);
+
+/**
+ * @brief Picks the kernels used by the palindrome and reverse functions (for benchmarking)
+ * @param name "scalar", "sse2" or "avx2", or NULL for the widest the CPU supports
+ * @return Name of the kernels in use
+ */
+const char *selectStringKernel(const char *name);
+
 /**
  * @brief Visualizes an array as a bar chart
  * @param arr Array to visualize
@@ -0,0 +1,280 @@
+/**
+ * @file range_sum_utils.c
+ * @brief Sums over ranges of integers without looping over them
+ * @version 1.0
+ * @date 2024
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "range_sum_utils.h"
+
+UInt128 sumRange(uint64_t lo, uint64_t hi)
+{
+    if (hi < lo)
+        return 0;
+
+    /* (lo + hi) * count / 2, halving whichever factor is even first */
+    UInt128 total = (UInt128)lo + hi;
+    UInt128 count = (UInt128)hi - lo + 1;
+    if (total % 2 == 0)
+        return total / 2 * count;
+    return total * (count / 2);
+}
+
+Int128 sumRangeSigned(int64_t lo, int64_t hi)
+{
+    if (hi < lo)
+        return 0;
+
+    /* lo + hi and the count have opposite parity, so one of them halves exactly */
+    Int128 total = (Int128)lo + hi;
+    Int128 count = (Int128)hi - lo + 1;
+    if (total % 2 == 0)
+        return total / 2 * count;
+    return total * (count / 2);
+}
+
+UInt128 sumArithmetic(uint64_t first, uint64_t step, uint64_t count)
+{
+    if (count == 0)
+        return 0;
+
+    /* count * first + step * (0 + 1 + ... + count-1) */
+    return (UInt128)first * count + (UInt128)step * sumRange(0, count - 1);
+}
+
+UInt128 sumOddUpTo(uint64_t n)
+{
+    /* 1 + 3 + ... + (2k-1) = k^2 */
+    UInt128 k = ((UInt128)n + 1) / 2;
+    return k * k;
+}
+
+UInt128 sumEvenUpTo(uint64_t n)
+{
+    /* 2 + 4 + ... + 2k = k(k+1) */
+    UInt128 k = n / 2;
+    return k * (k + 1);
+}
+
+/**
+ * @brief Computes the prefix sum 1^p + 2^p + ... + n^p for one p
+ *
+ * S_0..S_p are built up in turn from the recurrence
+ *   S_p(n) = ((n+1)^(p+1) - 1 - sum over k < p of C(p+1,k) S_k(n)) / (p+1)
+ */
+static void powerPrefixSum(BigNum *result, uint64_t n, int p)
+{
+    BigNum *sums = (BigNum *)malloc((p + 1) * sizeof(BigNum));
+    BigNum power, base, one, term;
+
+    if (sums == NULL)
+    {
+        printf("Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    bigNumInit(&power);
+    bigNumInit(&base);
+    bigNumInit(&one);
+    bigNumInit(&term);
+    bigNumSetU64(&one, 1);
+    bigNumSetU64(&base, n);
+    bigNumAdd(&base, &base, &one);
+    bigNumSetU64(&power, 1);
+
+    for (int q = 0; q <= p; q++)
+    {
+        /* power = (n+1)^(q+1) */
+        bigNumMul(&power, &power, &base);
+
+        bigNumInit(&sums[q]);
+        bigNumSub(&sums[q], &power, &one);
+
+        uint64_t binomial = 1; /* C(q+1, k) */
+        for (int k = 0; k < q; k++)
+        {
+            bigNumMulSmall(&term, &sums[k], (uint32_t)binomial);
+            bigNumSub(&sums[q], &sums[q], &term);
+            binomial = binomial * (q + 1 - k) / (k + 1);
+        }
+        bigNumDivSmall(&sums[q], &sums[q], q + 1);
+    }
+
+    bigNumSwap(result, &sums[p]);
+    for (int q = 0; q <= p; q++)
+        bigNumFree(&sums[q]);
+    free(sums);
+    bigNumFree(&power);
+    bigNumFree(&base);
+    bigNumFree(&one);
+    bigNumFree(&term);
+}
+
+int sumPowers(BigNum *result, uint64_t lo, uint64_t hi, int p)
+{
+    if (p < 0 || p > 32)
+        return -1;
+    if (hi < lo)
+    {
+        bigNumSetU64(result, 0);
+        return 0;
+    }
+
+    BigNum below;
+    bigNumInit(&below);
+    powerPrefixSum(result, hi, p);
+    if (lo > 1)
+    {
+        powerPrefixSum(&below, lo - 1, p);
+        bigNumSub(result, result, &below);
+    }
+    else if (lo == 0 && p == 0)
+    {
+        /* 0^0 counts as 1, so the range 0..hi has one more term */
+        bigNumSetU64(&below, 1);
+        bigNumAdd(result, result, &below);
+    }
+    bigNumFree(&below);
+    return 0;
+}
+
+/**
+ * @brief One thread's share of sumRangeIf()
+ */
+typedef struct {
+    uint64_t lo;
+    uint64_t hi;
+    RangePredicate pred;
+    void *ctx;
+    atomic_uint_fast64_t *done;
+    UInt128 sum;
+    pthread_t thread;
+} RangeSlice;
+
+static void *sumSlice(void *arg)
+{
+    RangeSlice *slice = (RangeSlice *)arg;
+    UInt128 acc[4] = {0, 0, 0, 0};
+    uint64_t i = slice->lo;
+    uint64_t remaining = slice->hi - slice->lo; /* numbers left after i */
+
+    /* four independent accumulators keep the adds off one dependency chain */
+    while (remaining >= 4)
+    {
+        uint64_t steps = remaining / 4;
+        if (steps > RANGE_PROGRESS_BATCH / 4)
+            steps = RANGE_PROGRESS_BATCH / 4;
+        for (uint64_t s = 0; s < steps; s++)
+        {
+            acc[0] += slice->pred(i, slice->ctx) ? i : 0;
+            acc[1] += slice->pred(i + 1, slice->ctx) ? i + 1 : 0;
+            acc[2] += slice->pred(i + 2, slice->ctx) ? i + 2 : 0;
+            acc[3] += slice->pred(i + 3, slice->ctx) ? i + 3 : 0;
+            i += 4;
+        }
+        remaining -= steps * 4;
+        if (slice->done != NULL)
+            atomic_fetch_add_explicit(slice->done, steps * 4, memory_order_relaxed);
+    }
+
+    uint64_t tail = remaining + 1;
+    for (;;)
+    {
+        acc[0] += slice->pred(i, slice->ctx) ? i : 0;
+        if (remaining-- == 0)
+            break;
+        i++;
+    }
+    if (slice->done != NULL)
+        atomic_fetch_add_explicit(slice->done, tail, memory_order_relaxed);
+
+    slice->sum = acc[0] + acc[1] + acc[2] + acc[3];
+    return NULL;
+}
+
+UInt128 sumRangeIf(uint64_t lo, uint64_t hi, RangePredicate pred, void *ctx, int threads)
+{
+    return sumRangeIfCounted(lo, hi, pred, ctx, threads, NULL);
+}
+
+UInt128 sumRangeIfCounted(uint64_t lo, uint64_t hi, RangePredicate pred, void *ctx, int threads,
+                          atomic_uint_fast64_t *done)
+{
+    if (hi < lo)
+        return 0;
+    if (threads < 1)
+        threads = 1;
+
+    uint64_t span = hi - lo;
+    if ((uint64_t)threads > span + 1)
+        threads = (int)(span + 1);
+
+    RangeSlice *slices = (RangeSlice *)calloc(threads, sizeof(RangeSlice));
+    if (slices == NULL)
+    {
+        printf("Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /*
+     * Even split of the span + 1 numbers: the first count % threads slices
+     * take one extra. threads <= span + 1, so no slice is empty.
+     */
+    UInt128 count = (UInt128)span + 1;
+    uint64_t per_thread = (uint64_t)(count / (unsigned)threads);
+    uint64_t extra = (uint64_t)(count % (unsigned)threads);
+    uint64_t start = lo;
+    for (int t = 0; t < threads; t++)
+    {
+        slices[t].lo = start;
+        slices[t].hi = start + (per_thread - 1) + ((uint64_t)t < extra);
+        slices[t].pred = pred;
+        slices[t].ctx = ctx;
+        slices[t].done = done;
+        start = slices[t].hi + 1;
+    }
+
+    for (int t = 1; t < threads; t++)
+        pthread_create(&slices[t].thread, NULL, sumSlice, &slices[t]);
+    sumSlice(&slices[0]);
+
+    UInt128 sum = slices[0].sum;
+    for (int t = 1; t < threads; t++)
+    {
+        pthread_join(slices[t].thread, NULL);
+        sum += slices[t].sum;
+    }
+    free(slices);
+    return sum;
+}
+
+char *uint128ToString(UInt128 value, char *buffer)
+{
+    char digits[40];
+    int length = 0;
+
+    do
+    {
+        digits[length++] = (char)('0' + (int)(value % 10));
+        value /= 10;
+    } while (value > 0);
+
+    for (int i = 0; i < length; i++)
+        buffer[i] = digits[length - 1 - i];
+    buffer[length] = '\0';
+    return buffer;
+}
+
+char *int128ToString(Int128 value, char *buffer)
+{
+    if (value >= 0)
+        return uint128ToString((UInt128)value, buffer);
+
+    /* negate as unsigned so the most negative value converts too */
+    buffer[0] = '-';
+    uint128ToString(-(UInt128)value, buffer + 1);
+    return buffer;
+}
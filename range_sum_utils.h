@@ -0,0 +1,141 @@
+/**
+ * @file range_sum_utils.h
+ * @brief Sums over ranges of integers without looping over them
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef RANGE_SUM_UTILS_H
+#define RANGE_SUM_UTILS_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include "bignum.h"
+
+/**
+ * @brief 128-bit unsigned integer (GCC/Clang extension)
+ */
+typedef unsigned __int128 UInt128;
+
+/**
+ * @brief 128-bit signed integer (GCC/Clang extension)
+ */
+typedef __int128 Int128;
+
+/**
+ * @brief Predicate for sumRangeIf()
+ * @param i Number to test
+ * @param ctx Caller data
+ * @return Non-zero if i should be added
+ */
+typedef int (*RangePredicate)(uint64_t i, void *ctx);
+
+/**
+ * @brief Numbers each thread of sumRangeIfCounted() tests between counter updates
+ */
+#define RANGE_PROGRESS_BATCH (1u << 16)
+
+/**
+ * @brief Sums lo + (lo+1) + ... + hi in O(1)
+ * @param lo First number
+ * @param hi Last number (the sum is 0 when hi < lo)
+ * @return The exact sum
+ */
+UInt128 sumRange(uint64_t lo, uint64_t hi);
+
+/**
+ * @brief Sums lo + (lo+1) + ... + hi in O(1) for bounds of either sign
+ * @param lo First number
+ * @param hi Last number (the sum is 0 when hi < lo)
+ * @return The exact sum
+ */
+Int128 sumRangeSigned(int64_t lo, int64_t hi);
+
+/**
+ * @brief Sums count terms of an arithmetic series in O(1)
+ * @param first First term
+ * @param step Difference between terms
+ * @param count Number of terms
+ * @return The sum, exact while it fits in 128 bits
+ */
+UInt128 sumArithmetic(uint64_t first, uint64_t step, uint64_t count);
+
+/**
+ * @brief Sums the odd numbers from 1 to n in O(1)
+ * @param n Upper limit (inclusive)
+ * @return The exact sum
+ */
+UInt128 sumOddUpTo(uint64_t n);
+
+/**
+ * @brief Sums the even numbers from 1 to n in O(1)
+ * @param n Upper limit (inclusive)
+ * @return The exact sum
+ */
+UInt128 sumEvenUpTo(uint64_t n);
+
+/**
+ * @brief Sums lo^p + (lo+1)^p + ... + hi^p exactly
+ *
+ * Uses the recurrence (n+1)^(p+1) - 1 = sum over k <= p of C(p+1,k) S_k(n),
+ * so the cost depends on p, not on the length of the range.
+ *
+ * @param result Receives the sum
+ * @param lo First number
+ * @param hi Last number (the sum is 0 when hi < lo)
+ * @param p Power, 0 to 32
+ * @return 0 on success, -1 if p is out of range
+ */
+int sumPowers(BigNum *result, uint64_t lo, uint64_t hi, int p);
+
+/**
+ * @brief Sums the numbers in lo..hi for which pred is true
+ *
+ * For sums with no closed form. The range is split across threads and
+ * each thread keeps several independent accumulators, so the cost is one
+ * predicate call per number divided by the thread count.
+ *
+ * @param lo First number
+ * @param hi Last number
+ * @param pred Predicate selecting the numbers to add
+ * @param ctx Passed to pred
+ * @param threads Number of threads to use
+ * @return The exact sum
+ */
+UInt128 sumRangeIf(uint64_t lo, uint64_t hi, RangePredicate pred, void *ctx, int threads);
+
+/**
+ * @brief sumRangeIf() that also counts the numbers tested so far
+ *
+ * Each thread adds to done once per RANGE_PROGRESS_BATCH numbers with a
+ * relaxed atomic add, so another thread can watch the counter (for example
+ * the `done` field of a premium_utils ProgressReporter) at almost no cost.
+ *
+ * @param lo First number
+ * @param hi Last number
+ * @param pred Predicate selecting the numbers to add
+ * @param ctx Passed to pred
+ * @param threads Number of threads to use
+ * @param done Counter to add to, or NULL
+ * @return The exact sum
+ */
+UInt128 sumRangeIfCounted(uint64_t lo, uint64_t hi, RangePredicate pred, void *ctx, int threads,
+                          atomic_uint_fast64_t *done);
+
+/**
+ * @brief Converts a 128-bit value to decimal
+ * @param value Value to convert
+ * @param buffer Buffer of at least 40 bytes
+ * @return buffer
+ */
+char *uint128ToString(UInt128 value, char *buffer);
+
+/**
+ * @brief Converts a signed 128-bit value to decimal
+ * @param value Value to convert
+ * @param buffer Buffer of at least 41 bytes
+ * @return buffer
+ */
+char *int128ToString(Int128 value, char *buffer);
+
+#endif /* RANGE_SUM_UTILS_H */
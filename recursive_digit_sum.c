@@ -10,10 +10,12 @@ int sumDigits(int no)
     return (no % 10) + sumDigits(no / 10);
 }
 
+#ifndef BENCHMARK_BUILD
 int main()
 {   int n;
     printf("Enter a number: ");
     scanf("%d", &n);
     printf("%d", sumDigits(n));
     return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,5 +1,32 @@
 #include <stdio.h>
-int main(){
+#include <stdlib.h>
+#include <string.h>
+#include "premium_utils.h"
+#include "pattern_utils.h"
+
+/* Compile: gcc triangle_pattern.c pattern_utils.c output_sink.c -o triangle_pattern -pthread (add -DPERF_COUNTERS=1 -DPREMIUM_UTILS_NO_MAIN premium_utils.c -lm for hardware counters) */
+/* Usage:   ./triangle_pattern [ROWS [OUTPUT_FILE [--direct]]]  (5 rows by default) */
+void printTriangle(FILE *out, int rows){
+    PERF_REGION_BEGIN(triangle);
+    patternPrint(out,PATTERN_TRIANGLE,rows);
+    PERF_REGION_END(triangle);
+}
+int writeTriangle(OutputSink *sink, int rows){
+    int result;
+    PERF_REGION_BEGIN(triangle);
+    result=patternWriteSink(sink,PATTERN_TRIANGLE,rows);
+    PERF_REGION_END(triangle);
+    return result;
+}
+#ifndef BENCHMARK_BUILD
+int main(int argc, char *argv[]){
+    OutputSink sink;
+    if(argc>2){
+        if(sinkOpenFile(&sink,argv[2],argc>3&&strcmp(argv[3],"--direct")==0?SINK_DIRECT:0)!=0)
+            return 1;
+        writeTriangle(&sink,atoi(argv[1]));
+        return sinkClose(&sink)==0?0:1;
+    }
     // char alpha;
     // printf("Enter a character in lowwercase to change in uppercase:");
     // scanf("%c",&alpha);
@@ -33,17 +60,9 @@ int main(){
     //     }
     //     printf("\n");
     // }
-    int i, j,k;
-     for ( i = 1; i <= 5; i++)
-     {
-        for( j = 5; j>i;j--){
-           printf(" ");
-        }
-        for(k=1;k<=i;k++){
-            printf("* ");
-        }
-        printf("\n");
-     }
+    sinkOpenStdout(&sink,SINK_SPLICE);
+    writeTriangle(&sink,argc>1?atoi(argv[1]):5);
+    sinkClose(&sink);
    
     // char k;
     // printf("enter  a character");
@@ -57,4 +76,5 @@ int main(){
     // }
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file